@@ -1,7 +1,42 @@
 #pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 #include <string>
 
+// ── Catalogue classification ──────────────────────────────────────────────────
+enum class ConductorMaterial : std::uint8_t { Cu, Al };
+enum class Insulation        : std::uint8_t { XLPE, EPR, PVC };
+
+// Short codes as stored in the database ("Cu", "XLPE", ...)
+inline const char* toString(ConductorMaterial m)
+{
+    return m == ConductorMaterial::Al ? "Al" : "Cu";
+}
+inline const char* toString(Insulation i)
+{
+    switch (i) {
+    case Insulation::EPR: return "EPR";
+    case Insulation::PVC: return "PVC";
+    default:              return "XLPE";
+    }
+}
+inline bool parseMaterial(const char* s, ConductorMaterial& out)
+{
+    if (std::strcmp(s, "Cu") == 0) { out = ConductorMaterial::Cu; return true; }
+    if (std::strcmp(s, "Al") == 0) { out = ConductorMaterial::Al; return true; }
+    return false;
+}
+inline bool parseInsulation(const char* s, Insulation& out)
+{
+    if (std::strcmp(s, "XLPE") == 0) { out = Insulation::XLPE; return true; }
+    if (std::strcmp(s, "EPR")  == 0) { out = Insulation::EPR;  return true; }
+    if (std::strcmp(s, "PVC")  == 0) { out = Insulation::PVC;  return true; }
+    return false;
+}
+
 // ── Plain data struct – all electrical parameters for one conductor size ──────
 struct CableRecord {
     int    sizeMm2                              = 0;
@@ -21,12 +56,18 @@ struct CableRecord {
     double screenDcResistance20C                = 0.0;
     double zeroSequenceResistance20C            = 0.0;
     double zeroSequenceReactance50Hz            = 0.0;
+
+    // Catalogue identity — defaults describe the built-in table below
+    int               manufacturerId            = 1;     // 1 = "Generic"
+    double            voltageKV                 = 33.0;  // Voltage class (U, kV)
+    ConductorMaterial material                  = ConductorMaterial::Cu;
+    Insulation        insulation                = Insulation::XLPE;
 };
 
 // ── Static table (mirrors the supplied JSON exactly) ─────────────────────────
-inline const std::vector<CableRecord>& cableDatabase()
-{
-    static const std::vector<CableRecord> db = {
+// constexpr so the offline fallback needs no heap or initialisation guard.
+// Must stay sorted by size; findBySize() relies on it.
+inline constexpr std::array<CableRecord, 14> kCableTable = {{
         {   50, 0.387,  0.494,  0.494,  -1,    0.163, 0.178, 0.224, 18000, 0.133, 0.796,  60.5, 4.05, 0.372, 0.759, 0.0999 },
         {   70, 0.268,  0.342,  0.342,  -1,    0.154, 0.169, 0.215, 16000, 0.148, 0.883,  67.1, 3.82, 0.263, 0.531, 0.0919 },
         {   95, 0.193,  0.247,  0.247,  -1,    0.143, 0.158, 0.204, 15000, 0.165, 0.984,  74.8, 3.61, 0.263, 0.457, 0.0817 },
@@ -41,13 +82,38 @@ inline const std::vector<CableRecord>& cableDatabase()
         {  800, 0.0221, 0.0336, 0.0315, -1,    0.102, 0.117, 0.163,  6300, 0.381, 2.27,  173.0, 2.78, 0.263, 0.289, 0.0452 },
         { 1000, 0.0182, 0.0245, 0.0240, -1,    0.100, 0.115, 0.161,  5600, 0.427, 2.55,  194.0, 2.72, 0.263, 0.282, 0.0441 },
         { 1200, 0.0150, 0.0207, 0.0201, -1,    0.0984,0.114, 0.159,  5200, 0.461, 2.75,  209.0, 2.68, 0.263, 0.279, 0.0426 },
-    };
-    return db;
+}};
+
+constexpr const std::array<CableRecord, 14>& cableDatabase() { return kCableTable; }
+
+constexpr bool cableTableSorted()
+{
+    for (size_t i = 1; i < kCableTable.size(); ++i)
+        if (kCableTable[i - 1].sizeMm2 >= kCableTable[i].sizeMm2) return false;
+    return true;
 }
+static_assert(cableTableSorted(), "kCableTable must be sorted by size, no duplicates");
 
-inline const CableRecord* findBySize(int sizeMm2)
+// Binary search; folds to a constant for a literal size
+constexpr const CableRecord* findBySize(int sizeMm2)
 {
-    for (const auto& r : cableDatabase())
-        if (r.sizeMm2 == sizeMm2) return &r;
-    return nullptr;
+    size_t lo = 0, hi = kCableTable.size();
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (kCableTable[mid].sizeMm2 < sizeMm2) lo = mid + 1;
+        else                                    hi = mid;
+    }
+    return (lo < kCableTable.size() && kCableTable[lo].sizeMm2 == sizeMm2)
+        ? &kCableTable[lo] : nullptr;
 }
+
+// Compile-time lookup — a size missing from the table fails to build
+template <int SizeMm2>
+constexpr const CableRecord& cableRecord()
+{
+    static_assert(findBySize(SizeMm2) != nullptr, "size not in kCableTable");
+    return *findBySize(SizeMm2);
+}
+
+static_assert(cableRecord<240>().acResistanceTrefoilTouching == 0.0976, "table lookup");
+static_assert(findBySize(241) == nullptr, "table lookup");
@@ -0,0 +1,530 @@
+#include "CatalogueImport.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace catalogue {
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Field table — column name → CableRecord member
+// ─────────────────────────────────────────────────────────────────────────────
+namespace {
+
+enum class Kind { Real, Size, Manufacturer, Material, Insulation };
+
+struct Field {
+    const char*           name;
+    double CableRecord::* member;   // Kind::Real only
+    Kind                  kind = Kind::Real;
+};
+
+const Field kFields[] = {
+    { "size_mm2",                                                 nullptr, Kind::Size },
+    { "manufacturer",                                             nullptr, Kind::Manufacturer },
+    { "conductor_material",                                       nullptr, Kind::Material },
+    { "insulation",                                               nullptr, Kind::Insulation },
+    { "voltage_kv",                                               &CableRecord::voltageKV },
+    { "max_dc_resistance_20C_ohm_per_km",                         &CableRecord::maxDcResistance20C },
+    { "ac_resistance_50hz_90C_trefoil_touching_ohm_per_km",       &CableRecord::acResistanceTrefoilTouching },
+    { "ac_resistance_50hz_90C_flat_touching_ohm_per_km",          &CableRecord::acResistanceFlatTouching },
+    { "ac_resistance_50hz_90C_flat_spaced_ohm_per_km",            &CableRecord::acResistanceFlatSpaced },
+    { "inductive_reactance_50hz_90C_trefoil_touching_ohm_per_km", &CableRecord::inductiveReactanceTrefoilTouching },
+    { "inductive_reactance_50hz_90C_flat_touching_ohm_per_km",    &CableRecord::inductiveReactanceFlatTouching },
+    { "inductive_reactance_50hz_90C_flat_spaced_ohm_per_km",      &CableRecord::inductiveReactanceFlatSpaced },
+    { "insulation_resistance_20C_Mohm_km",                        &CableRecord::insulationResistance20C },
+    { "conductor_to_screen_capacitance_uF_per_km",                &CableRecord::conductorToScreenCapacitance },
+    { "charging_current_per_phase_A_per_km",                      &CableRecord::chargingCurrentPerPhase },
+    { "dielectric_loss_per_phase_W_per_km",                       &CableRecord::dielectricLossPerPhase },
+    { "max_dielectric_stress_kV_per_mm",                          &CableRecord::maxDielectricStress },
+    { "screen_dc_resistance_20C_ohm_per_km",                      &CableRecord::screenDcResistance20C },
+    { "zero_sequence_resistance_20C_ohm_per_km",                  &CableRecord::zeroSequenceResistance20C },
+    { "zero_sequence_reactance_50hz_ohm_per_km",                  &CableRecord::zeroSequenceReactance50Hz },
+};
+
+// Index into kFields, or -1 if the name is not a known field
+int fieldIndex(const char* name, size_t len)
+{
+    for (size_t i = 0; i < sizeof(kFields) / sizeof(kFields[0]); ++i)
+        if (std::strlen(kFields[i].name) == len &&
+            std::memcmp(kFields[i].name, name, len) == 0)
+            return static_cast<int>(i);
+    return -1;
+}
+
+bool isText(int field) { return field >= 0 && kFields[field].kind >= Kind::Manufacturer; }
+
+// Numeric fields; false if `v` is out of range for the field.  Every quantity
+// in the catalogue is finite and >= 0, and size_mm2 is a whole number in int
+// range (strtod also accepts "nan", "inf", negatives and "1e20").
+bool assign(CableRecord& r, int field, double v)
+{
+    if (!std::isfinite(v) || v < 0.0) return false;
+    if (kFields[field].member) {
+        r.*kFields[field].member = v;
+        return true;
+    }
+    if (v != std::floor(v) || v > std::numeric_limits<int>::max())
+        return false;
+    r.sizeMm2 = static_cast<int>(v);
+    return true;
+}
+
+// Text fields; false with `error` set if the value is not recognised.
+// Manufacturer names are interned into `names`, and the record takes the
+// 1-based position (see CatalogueImport.h).
+bool assignText(CableRecord& r, int field, const std::string& v,
+                std::vector<std::string>& names, std::string& error)
+{
+    switch (kFields[field].kind) {
+    case Kind::Manufacturer: {
+        auto it = std::find(names.begin(), names.end(), v);
+        if (it == names.end()) it = names.insert(names.end(), v);
+        r.manufacturerId = static_cast<int>(it - names.begin()) + 1;
+        return true;
+    }
+    case Kind::Material:
+        if (parseMaterial(v.c_str(), r.material)) return true;
+        error = "unknown conductor_material '" + v + "'";
+        return false;
+    case Kind::Insulation:
+        if (parseInsulation(v.c_str(), r.insulation)) return true;
+        error = "unknown insulation '" + v + "'";
+        return false;
+    default:
+        return false;
+    }
+}
+
+// strtod over [b, e) — true only if the whole range is one number
+bool toNumber(const char* b, const char* e, double& v)
+{
+    char buf[64];
+    const size_t n = static_cast<size_t>(e - b);
+    if (n == 0 || n >= sizeof(buf)) return false;
+    std::memcpy(buf, b, n);
+    buf[n] = '\0';
+    char* end = nullptr;
+    v = std::strtod(buf, &end);
+    return end == buf + n;
+}
+
+void appendUtf8(std::string& s, unsigned cp)
+{
+    if (cp < 0x80) {
+        s.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        s.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        s.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        s.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        s.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        s.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        s.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        s.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        s.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        s.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+}
+
+int lineAt(const std::string& text, size_t pos)
+{
+    return 1 + static_cast<int>(std::count(text.begin(),
+                                           text.begin() + std::min(pos, text.size()), '\n'));
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// CSV
+// ─────────────────────────────────────────────────────────────────────────────
+bool parseCsv(const std::string& text, std::vector<CableRecord>& out,
+              std::vector<std::string>& manufacturers, std::string& error)
+{
+    if (manufacturers.empty()) manufacturers.push_back("Generic");
+
+    const char* p   = text.data();
+    const char* end = p + text.size();
+    int line     = 0;   // First line of the record just read
+    int nextLine = 1;
+
+    // Read the record starting at p into trimmed, unquoted cells (RFC 4180:
+    // a quoted field may hold commas, newlines and "" for a quote).  Cell
+    // text is copied into `buf`, which keeps its capacity between records.
+    // False with `error` set on quoting that cannot be read unambiguously.
+    std::string buf;
+    std::vector<std::pair<size_t, size_t>>           spans;
+    std::vector<std::pair<const char*, const char*>> cells;
+    auto isBlank = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+    auto readLine = [&]() -> bool {
+        buf.clear();
+        spans.clear();
+        line = nextLine;
+        for (;;) {
+            while (p < end && isBlank(*p)) ++p;
+            const size_t b = buf.size();
+            if (p < end && *p == '"') {
+                for (++p;; ++p) {
+                    if (p == end) {
+                        error = "Line " + std::to_string(line) + ": unterminated quoted field";
+                        return false;
+                    }
+                    if (*p == '"') {
+                        if (p + 1 < end && p[1] == '"') { buf += '"'; ++p; continue; }
+                        ++p;
+                        break;
+                    }
+                    if (*p == '\n') ++nextLine;
+                    buf += *p;
+                }
+                while (p < end && isBlank(*p)) ++p;
+                if (p < end && *p != ',' && *p != '\n') {
+                    error = "Line " + std::to_string(nextLine)
+                          + ": unexpected text after a closing quote";
+                    return false;
+                }
+            } else {
+                const char* c = p;
+                while (p < end && *p != ',' && *p != '\n') {
+                    if (*p == '"') {
+                        error = "Line " + std::to_string(nextLine)
+                              + ": quote inside an unquoted field";
+                        return false;
+                    }
+                    ++p;
+                }
+                const char* e = p;
+                while (e > c && std::isspace(static_cast<unsigned char>(e[-1]))) --e;
+                buf.append(c, e);
+            }
+            spans.emplace_back(b, buf.size());
+            if (p < end && *p == ',') { ++p; continue; }
+            if (p < end) ++p;   // '\n'
+            ++nextLine;
+            break;
+        }
+        cells.clear();
+        for (const auto& s : spans)
+            cells.emplace_back(buf.data() + s.first, buf.data() + s.second);
+        return true;
+    };
+
+    // Header
+    std::vector<int> columns;
+    while (p < end && columns.empty()) {
+        if (!readLine()) return false;
+        if (cells.size() == 1 && cells[0].first == cells[0].second) continue;  // blank
+        for (const auto& c : cells)
+            columns.push_back(fieldIndex(c.first, static_cast<size_t>(c.second - c.first)));
+    }
+    if (std::find(columns.begin(), columns.end(), 0) == columns.end()) {
+        error = "CSV header has no size_mm2 column";
+        return false;
+    }
+
+    out.reserve(out.size() + static_cast<size_t>(std::count(p, end, '\n')) + 1);
+
+    while (p < end) {
+        if (!readLine()) return false;
+        if (cells.size() == 1 && cells[0].first == cells[0].second) continue;  // blank
+
+        CableRecord r;
+        for (size_t i = 0; i < cells.size() && i < columns.size(); ++i) {
+            if (columns[i] < 0 || cells[i].first == cells[i].second) continue;
+            if (isText(columns[i])) {
+                std::string msg;
+                if (!assignText(r, columns[i], std::string(cells[i].first, cells[i].second),
+                                manufacturers, msg)) {
+                    error = "Line " + std::to_string(line) + ": " + msg;
+                    return false;
+                }
+                continue;
+            }
+            double v = 0.0;
+            if (!toNumber(cells[i].first, cells[i].second, v)) {
+                error = "Line " + std::to_string(line) + ": bad number '"
+                      + std::string(cells[i].first, cells[i].second) + "'";
+                return false;
+            }
+            if (!assign(r, columns[i], v)) {
+                error = "Line " + std::to_string(line) + ": bad " + kFields[columns[i]].name
+                      + " '" + std::string(cells[i].first, cells[i].second) + "'";
+                return false;
+            }
+        }
+        if (r.sizeMm2 <= 0) {
+            error = "Line " + std::to_string(line) + ": size_mm2 missing or not > 0";
+            return false;
+        }
+        out.push_back(r);
+    }
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// JSON — just enough for arrays of flat records
+// ─────────────────────────────────────────────────────────────────────────────
+namespace {
+
+class JsonReader {
+public:
+    JsonReader(const std::string& text, std::vector<std::string>& manufacturers)
+        : m_text(text), m_names(manufacturers) {}
+
+    bool parse(std::vector<CableRecord>& out, std::string& error)
+    {
+        skipWs();
+        bool ok = false;
+        if (peek() == '[') {
+            ok = records(out);
+        } else if (peek() == '{') {
+            // First array value of the top-level object holds the records
+            ++m_pos;
+            bool found = false;
+            skipWs();
+            if (peek() == '}') { ++m_pos; ok = true; }
+            while (!m_failed && !ok) {
+                skipWs();
+                std::string key;
+                if (!string(key) || !expect(':')) break;
+                skipWs();
+                if (!found && peek() == '[') { found = true; if (!records(out)) break; }
+                else if (!skipValue())       break;
+                skipWs();
+                if (peek() == ',') { ++m_pos; continue; }
+                ok = expect('}');
+                break;
+            }
+            if (ok && !found) fail("no array of records found");
+            ok = ok && found;
+        } else {
+            fail("expected '[' or '{'");
+        }
+
+        if (!ok) {
+            error = "Line " + std::to_string(lineAt(m_text, m_pos)) + ": " + m_error;
+            return false;
+        }
+        return true;
+    }
+
+private:
+    char peek() const { return m_pos < m_text.size() ? m_text[m_pos] : '\0'; }
+
+    bool fail(const std::string& msg)
+    {
+        if (!m_failed) { m_failed = true; m_error = msg; }
+        return false;
+    }
+
+    void skipWs()
+    {
+        while (m_pos < m_text.size() &&
+               std::isspace(static_cast<unsigned char>(m_text[m_pos])))
+            ++m_pos;
+    }
+
+    bool expect(char c)
+    {
+        skipWs();
+        if (peek() != c) return fail(std::string("expected '") + c + "'");
+        ++m_pos;
+        return true;
+    }
+
+    bool string(std::string& s)
+    {
+        if (!expect('"')) return false;
+        s.clear();
+        while (m_pos < m_text.size() && m_text[m_pos] != '"') {
+            const char c = m_text[m_pos++];
+            if (c != '\\') s.push_back(c);
+            else if (!escape(s)) return false;
+        }
+        if (m_pos >= m_text.size()) return fail("unterminated string");
+        ++m_pos;
+        return true;
+    }
+
+    // The escape after a backslash, decoded onto `s` (\uXXXX as UTF-8)
+    bool escape(std::string& s)
+    {
+        if (m_pos >= m_text.size()) return fail("unterminated string");
+        const char c = m_text[m_pos++];
+        switch (c) {
+        case '"': case '\\': case '/': s.push_back(c);    return true;
+        case 'b':                      s.push_back('\b'); return true;
+        case 'f':                      s.push_back('\f'); return true;
+        case 'n':                      s.push_back('\n'); return true;
+        case 'r':                      s.push_back('\r'); return true;
+        case 't':                      s.push_back('\t'); return true;
+        case 'u':                      break;
+        default:  return fail(std::string("bad escape '\\") + c + "'");
+        }
+
+        unsigned cp;
+        if (!hex4(cp)) return false;
+        if (cp >= 0xD800 && cp < 0xDC00) {   // High surrogate; the low half must follow
+            unsigned lo;
+            if (m_text.compare(m_pos, 2, "\\u") != 0) return fail("unpaired surrogate in \\u escape");
+            m_pos += 2;
+            if (!hex4(lo)) return false;
+            if (lo < 0xDC00 || lo > 0xDFFF) return fail("unpaired surrogate in \\u escape");
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+        } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+            return fail("unpaired surrogate in \\u escape");
+        }
+        appendUtf8(s, cp);
+        return true;
+    }
+
+    bool hex4(unsigned& v)
+    {
+        v = 0;
+        for (int i = 0; i < 4; ++i, ++m_pos) {
+            const char c = peek();
+            if (!std::isxdigit(static_cast<unsigned char>(c))) return fail("bad \\u escape");
+            v = v * 16 + static_cast<unsigned>(std::isdigit(static_cast<unsigned char>(c))
+                       ? c - '0' : std::tolower(static_cast<unsigned char>(c)) - 'a' + 10);
+        }
+        return true;
+    }
+
+    bool number(double& v)
+    {
+        const size_t b = m_pos;
+        while (m_pos < m_text.size() &&
+               std::strchr("+-.0123456789eE", m_text[m_pos]) != nullptr)
+            ++m_pos;
+        if (!toNumber(m_text.data() + b, m_text.data() + m_pos, v))
+            return fail("bad number");
+        return true;
+    }
+
+    bool literal(const char* word)
+    {
+        const size_t n = std::strlen(word);
+        if (m_text.compare(m_pos, n, word) != 0) return fail("unexpected token");
+        m_pos += n;
+        return true;
+    }
+
+    bool skipValue()
+    {
+        skipWs();
+        const char c = peek();
+        if (c == '"') { std::string s; return string(s); }
+        if (c == 't') return literal("true");
+        if (c == 'f') return literal("false");
+        if (c == 'n') return literal("null");
+        if (c == '[' || c == '{') {
+            const char close = (c == '[') ? ']' : '}';
+            ++m_pos;
+            skipWs();
+            if (peek() == close) { ++m_pos; return true; }
+            while (true) {
+                if (c == '{') {
+                    std::string key;
+                    if (!string(key) || !expect(':')) return false;
+                }
+                if (!skipValue()) return false;
+                skipWs();
+                if (peek() == ',') { ++m_pos; continue; }
+                return expect(close);
+            }
+        }
+        double v;
+        return number(v);
+    }
+
+    bool record(CableRecord& r)
+    {
+        if (!expect('{')) return false;
+        skipWs();
+        if (peek() == '}') { ++m_pos; return true; }
+        std::string key;
+        while (true) {
+            if (!string(key) || !expect(':')) return false;
+            skipWs();
+            const int field = fieldIndex(key.data(), key.size());
+            const char c = peek();
+            if (isText(field) && c == '"') {
+                std::string v, msg;
+                if (!string(v)) return false;
+                if (!assignText(r, field, v, m_names, msg)) return fail(msg);
+            } else if (field >= 0 && !isText(field) &&
+                       (c == '-' || std::isdigit(static_cast<unsigned char>(c)))) {
+                double v;
+                if (!number(v)) return false;
+                if (!assign(r, field, v)) return fail(std::string("bad ") + kFields[field].name);
+            } else if (!skipValue()) {   // null, strings, unknown fields
+                return false;
+            }
+            skipWs();
+            if (peek() == ',') { ++m_pos; continue; }
+            return expect('}');
+        }
+    }
+
+    bool records(std::vector<CableRecord>& out)
+    {
+        if (!expect('[')) return false;
+        skipWs();
+        if (peek() == ']') { ++m_pos; return true; }
+        while (true) {
+            CableRecord r;
+            if (!record(r)) return false;
+            if (r.sizeMm2 <= 0) return fail("record without size_mm2 > 0");
+            out.push_back(r);
+            skipWs();
+            if (peek() == ',') { ++m_pos; continue; }
+            return expect(']');
+        }
+    }
+
+    const std::string&        m_text;
+    std::vector<std::string>& m_names;
+    size_t             m_pos    = 0;
+    bool               m_failed = false;
+    std::string        m_error;
+};
+
+} // namespace
+
+bool parseJson(const std::string& text, std::vector<CableRecord>& out,
+               std::vector<std::string>& manufacturers, std::string& error)
+{
+    if (manufacturers.empty()) manufacturers.push_back("Generic");
+    return JsonReader(text, manufacturers).parse(out, error);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// File dispatch
+// ─────────────────────────────────────────────────────────────────────────────
+bool parseFile(const std::string& path, std::vector<CableRecord>& out,
+               std::vector<std::string>& manufacturers, std::string& error)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        error = "Cannot open " + path;
+        return false;
+    }
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    const std::string text = ss.str();
+
+    std::string ext = path.size() >= 5 ? path.substr(path.size() - 5) : "";
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    return (ext == ".json") ? parseJson(text, out, manufacturers, error)
+                            : parseCsv (text, out, manufacturers, error);
+}
+
+} // namespace catalogue
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CableData.h"
+#include <string>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// CatalogueImport
+//   Parses manufacturer catalogues into CableRecords for
+//   DatabaseManager::importRecords().
+//
+//   Field names are the cable_electrical_data column names plus `size_mm2`,
+//   e.g. ac_resistance_50hz_90C_trefoil_touching_ohm_per_km.  Unknown fields
+//   are ignored; missing or empty/null values keep the CableRecord default
+//   (null flat-spaced resistance reads as -1, "not available").
+//
+//   The catalogue key fields are `manufacturer` (a name), `voltage_kv`,
+//   `conductor_material` (Cu / Al) and `insulation` (XLPE / EPR / PVC).
+//   Manufacturer names are collected in `manufacturers`, with "Generic" as
+//   entry 0; each record's manufacturerId is its name's position + 1, to be
+//   mapped to database ids (DatabaseManager::manufacturerId) before import.
+//
+//   CSV  — first line is a header of field names; comma separated, with
+//          RFC 4180 quoting ("Nexans, Inc.", "" for a quote).
+//   JSON — an array of flat objects, either top-level or as the first array
+//          value of the top-level object (e.g. { "cables": [ ... ] }).
+// ─────────────────────────────────────────────────────────────────────────────
+namespace catalogue {
+
+// Parse `path`; the format is chosen by extension (.json, otherwise CSV).
+// Returns false with `error` set (including the line number) on bad input.
+bool parseFile(const std::string& path, std::vector<CableRecord>& out,
+               std::vector<std::string>& manufacturers, std::string& error);
+
+bool parseCsv (const std::string& text, std::vector<CableRecord>& out,
+               std::vector<std::string>& manufacturers, std::string& error);
+bool parseJson(const std::string& text, std::vector<CableRecord>& out,
+               std::vector<std::string>& manufacturers, std::string& error);
+
+} // namespace catalogue
@@ -0,0 +1,193 @@
+#include "CatalogueSnapshot.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#ifdef _WIN32
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// File format
+// ─────────────────────────────────────────────────────────────────────────────
+namespace {
+
+// Bump when CableRecord changes meaning without changing size
+constexpr std::uint32_t kFormatVersion = 2;
+constexpr char          kMagic[8]      = { 'C','B','L','S','N','A','P','\0' };
+constexpr std::uint32_t kByteOrder     = 0x01020304;
+
+struct Header {
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint32_t recordSize;
+    std::uint32_t reserved;
+    std::uint64_t count;
+    std::int64_t  catalogueVersion;
+};
+
+// Records start here; keeps them aligned for every CableRecord member
+constexpr size_t kRecordsOffset = 64;
+static_assert(sizeof(Header) <= kRecordsOffset, "snapshot header outgrew its slot");
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Writing
+// ─────────────────────────────────────────────────────────────────────────────
+std::string CatalogueSnapshot::pathFor(const std::string& dbPath)
+{
+    return fs::path(dbPath).replace_extension(".snapshot").string();
+}
+
+bool CatalogueSnapshot::write(const std::string& path,
+                              const std::vector<CableRecord>& records,
+                              long long catalogueVersion, std::string& error)
+{
+    Header h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version    = kFormatVersion;
+    h.byteOrder  = kByteOrder;
+    h.recordSize = static_cast<std::uint32_t>(sizeof(CableRecord));
+    h.count      = records.size();
+    h.catalogueVersion = catalogueVersion;
+
+    char head[kRecordsOffset] = {};
+    std::memcpy(head, &h, sizeof(h));
+
+    const std::string tmp = path + ".tmp";
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) {
+        error = "Cannot create " + tmp;
+        return false;
+    }
+    bool ok = std::fwrite(head, sizeof(head), 1, f) == 1;
+    if (ok && !records.empty())
+        ok = std::fwrite(records.data(), sizeof(CableRecord), records.size(), f)
+             == records.size();
+    ok = (std::fclose(f) == 0) && ok;
+
+    std::error_code ec;
+    if (ok) fs::rename(tmp, path, ec);   // Replaces an existing snapshot
+    if (!ok || ec) {
+        fs::remove(tmp, ec);
+        error = "Cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Mapping
+// ─────────────────────────────────────────────────────────────────────────────
+CatalogueSnapshot::~CatalogueSnapshot()
+{
+    close();
+}
+
+bool CatalogueSnapshot::open(const std::string& path)
+{
+    close();
+
+    // The view stays valid after its file and mapping handles are closed
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        m_error = "Cannot open " + path;
+        return false;
+    }
+    LARGE_INTEGER length{};
+    GetFileSizeEx(file, &length);
+    HANDLE mapping = length.QuadPart > 0
+        ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)
+        : nullptr;
+    CloseHandle(file);
+    if (!mapping) {
+        m_error = "Cannot map " + path;
+        return false;
+    }
+    m_base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    m_length = static_cast<size_t>(length.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        m_error = "Cannot open " + path;
+        return false;
+    }
+    struct stat st{};
+    void* base = (::fstat(fd, &st) == 0 && st.st_size > 0)
+        ? ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0)
+        : MAP_FAILED;
+    ::close(fd);
+    m_base   = (base == MAP_FAILED) ? nullptr : base;
+    m_length = static_cast<size_t>(st.st_size);
+#endif
+    if (!m_base) {
+        m_error = "Cannot map " + path;
+        return false;
+    }
+
+    Header h;
+    if (m_length < kRecordsOffset) {
+        close();
+        m_error = path + ": truncated";
+        return false;
+    }
+    std::memcpy(&h, m_base, sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 ||
+        h.version != kFormatVersion || h.byteOrder != kByteOrder ||
+        h.recordSize != sizeof(CableRecord)) {
+        close();
+        m_error = path + ": not a snapshot for this build";
+        return false;
+    }
+    if (h.count > (m_length - kRecordsOffset) / sizeof(CableRecord)) {
+        close();
+        m_error = path + ": truncated";
+        return false;
+    }
+
+    m_records = reinterpret_cast<const CableRecord*>(
+        static_cast<const char*>(m_base) + kRecordsOffset);
+    m_count   = static_cast<size_t>(h.count);
+    return true;
+}
+
+void CatalogueSnapshot::close()
+{
+    if (m_base) {
+#ifdef _WIN32
+        UnmapViewOfFile(m_base);
+#else
+        ::munmap(const_cast<void*>(m_base), m_length);
+#endif
+    }
+    m_base    = nullptr;
+    m_length  = 0;
+    m_records = nullptr;
+    m_count   = 0;
+}
+
+bool CatalogueSnapshot::isCurrent(long long catalogueVersion) const
+{
+    if (!m_base || catalogueVersion < 0) return false;
+
+    Header h;
+    std::memcpy(&h, m_base, sizeof(h));
+    return h.catalogueVersion == catalogueVersion;
+}
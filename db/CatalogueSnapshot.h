@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CableData.h"
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Records are stored and mapped as raw bytes
+static_assert(std::is_trivially_copyable<CableRecord>::value,
+              "CableRecord must stay trivially copyable for CatalogueSnapshot");
+
+// ─────────────────────────────────────────────────────────────────────────────
+// CatalogueSnapshot
+//   Read-only binary copy of the cable catalogue, memory-mapped so records
+//   are usable straight from the file with no parsing.
+//
+//   Layout: a fixed header (magic, format version, sizeof(CableRecord),
+//   record count, catalogue version) followed by the CableRecord array.  A
+//   file written by a build with a different format or record layout is
+//   rejected by open(), as is a truncated one.
+//
+//   The catalogue version is DatabaseManager::catalogueVersion() of the
+//   records written; isCurrent() compares it with the database's.  Writes
+//   that do not touch the catalogue, such as saved studies, leave it alone.
+// ─────────────────────────────────────────────────────────────────────────────
+class CatalogueSnapshot
+{
+public:
+    CatalogueSnapshot() = default;
+    ~CatalogueSnapshot();
+
+    // Non-copyable
+    CatalogueSnapshot(const CatalogueSnapshot&)            = delete;
+    CatalogueSnapshot& operator=(const CatalogueSnapshot&) = delete;
+
+    // "cable_design.db" → "cable_design.snapshot"
+    static std::string pathFor(const std::string& dbPath);
+
+    // Write `records` to `path` (via a temporary file, so readers never see
+    // a partial snapshot), stamped with the catalogue version they came from.
+    static bool write(const std::string& path, const std::vector<CableRecord>& records,
+                      long long catalogueVersion, std::string& error);
+
+    // Map and validate `path`.  Returns false if it is missing or invalid.
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return m_records != nullptr; }
+    bool isCurrent(long long catalogueVersion) const;
+
+    const CableRecord* begin() const { return m_records; }
+    const CableRecord* end()   const { return m_records + m_count; }
+    size_t             size()  const { return m_count; }
+
+    std::string errorMessage() const { return m_error; }
+
+private:
+    const void*        m_base    = nullptr;   // Mapped view
+    size_t             m_length  = 0;
+    const CableRecord* m_records = nullptr;
+    size_t             m_count   = 0;
+    std::string        m_error;
+};
@@ -5,8 +5,11 @@
 // target (see CMakeLists.txt) we only need the header here.
 #include <sqlite3.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <sstream>
+#include <unordered_map>
 
 // ─────────────────────────────────────────────────────────────────────────────
 // Helpers
@@ -16,9 +19,303 @@ static std::string sqliteError(sqlite3* db)
     return db ? sqlite3_errmsg(db) : "null handle";
 }
 
+// Columns read by readRecord(), in order
+static const char* const kRecordSelect = R"(
+        SELECT
+            s.size_mm2,
+            e.max_dc_resistance_20C_ohm_per_km,
+            e.ac_resistance_50hz_90C_trefoil_touching_ohm_per_km,
+            e.ac_resistance_50hz_90C_flat_touching_ohm_per_km,
+            e.ac_resistance_50hz_90C_flat_spaced_ohm_per_km,
+            e.inductive_reactance_50hz_90C_trefoil_touching_ohm_per_km,
+            e.inductive_reactance_50hz_90C_flat_touching_ohm_per_km,
+            e.inductive_reactance_50hz_90C_flat_spaced_ohm_per_km,
+            e.insulation_resistance_20C_Mohm_km,
+            e.conductor_to_screen_capacitance_uF_per_km,
+            e.charging_current_per_phase_A_per_km,
+            e.dielectric_loss_per_phase_W_per_km,
+            e.max_dielectric_stress_kV_per_mm,
+            e.screen_dc_resistance_20C_ohm_per_km,
+            e.zero_sequence_resistance_20C_ohm_per_km,
+            e.zero_sequence_reactance_50hz_ohm_per_km,
+            e.manufacturer_id,
+            e.voltage_kv,
+            e.conductor_material,
+            e.insulation
+        FROM cable_electrical_data e
+        JOIN cable_size s ON s.id = e.cable_size_id
+)";
+
+// Record order used throughout: size, then the catalogue key
+static const char* const kRecordOrder =
+    "ORDER BY s.size_mm2, e.manufacturer_id, e.voltage_kv, e.conductor_material, e.insulation";
+
+static CableRecord readRecord(sqlite3_stmt* stmt)
+{
+    auto colReal = [&](int col) -> double {
+        if (sqlite3_column_type(stmt, col) == SQLITE_NULL) return -1.0;
+        return sqlite3_column_double(stmt, col);
+    };
+
+    CableRecord r;
+    r.sizeMm2                          = sqlite3_column_int(stmt, 0);
+    r.maxDcResistance20C               = colReal(1);
+    r.acResistanceTrefoilTouching      = colReal(2);
+    r.acResistanceFlatTouching         = colReal(3);
+    r.acResistanceFlatSpaced           = colReal(4);
+    r.inductiveReactanceTrefoilTouching = colReal(5);
+    r.inductiveReactanceFlatTouching   = colReal(6);
+    r.inductiveReactanceFlatSpaced     = colReal(7);
+    r.insulationResistance20C          = colReal(8);
+    r.conductorToScreenCapacitance     = colReal(9);
+    r.chargingCurrentPerPhase          = colReal(10);
+    r.dielectricLossPerPhase           = colReal(11);
+    r.maxDielectricStress              = colReal(12);
+    r.screenDcResistance20C            = colReal(13);
+    r.zeroSequenceResistance20C        = colReal(14);
+    r.zeroSequenceReactance50Hz        = colReal(15);
+    r.manufacturerId                   = sqlite3_column_int(stmt, 16);
+    r.voltageKV                        = sqlite3_column_double(stmt, 17);
+
+    auto colText = [&](int col) -> const char* {
+        const unsigned char* t = sqlite3_column_text(stmt, col);
+        return t ? reinterpret_cast<const char*>(t) : "";
+    };
+    parseMaterial  (colText(18), r.material);
+    parseInsulation(colText(19), r.insulation);
+    return r;
+}
+
+// Same order as kRecordOrder
+static bool recordLess(const CableRecord& a, const CableRecord& b)
+{
+    if (a.sizeMm2        != b.sizeMm2)        return a.sizeMm2        < b.sizeMm2;
+    if (a.manufacturerId != b.manufacturerId) return a.manufacturerId < b.manufacturerId;
+    if (a.voltageKV      != b.voltageKV)      return a.voltageKV      < b.voltageKV;
+    if (a.material       != b.material)
+        return std::strcmp(toString(a.material), toString(b.material)) < 0;
+    return std::strcmp(toString(a.insulation), toString(b.insulation)) < 0;
+}
+
+// Bind parameters 1–20 of the InsertElectrical statement
+static void bindElectrical(sqlite3_stmt* s, sqlite3_int64 sizeId, const CableRecord& c)
+{
+    auto bindReal = [&](int col, double v) {
+        if (v < 0)
+            sqlite3_bind_null(s, col);
+        else
+            sqlite3_bind_double(s, col, v);
+    };
+
+    sqlite3_bind_int64(s,  1, sizeId);
+    sqlite3_bind_double(s, 2,  c.maxDcResistance20C);
+    sqlite3_bind_double(s, 3,  c.acResistanceTrefoilTouching);
+    sqlite3_bind_double(s, 4,  c.acResistanceFlatTouching);
+    bindReal(              5,  c.acResistanceFlatSpaced);
+    sqlite3_bind_double(s, 6,  c.inductiveReactanceTrefoilTouching);
+    sqlite3_bind_double(s, 7,  c.inductiveReactanceFlatTouching);
+    sqlite3_bind_double(s, 8,  c.inductiveReactanceFlatSpaced);
+    sqlite3_bind_double(s, 9,  c.insulationResistance20C);
+    sqlite3_bind_double(s, 10, c.conductorToScreenCapacitance);
+    sqlite3_bind_double(s, 11, c.chargingCurrentPerPhase);
+    sqlite3_bind_double(s, 12, c.dielectricLossPerPhase);
+    sqlite3_bind_double(s, 13, c.maxDielectricStress);
+    sqlite3_bind_double(s, 14, c.screenDcResistance20C);
+    sqlite3_bind_double(s, 15, c.zeroSequenceResistance20C);
+    sqlite3_bind_double(s, 16, c.zeroSequenceReactance50Hz);
+    sqlite3_bind_int(s,    17, c.manufacturerId);
+    sqlite3_bind_double(s, 18, c.voltageKV);
+    sqlite3_bind_text(s,   19, toString(c.material),   -1, SQLITE_STATIC);
+    sqlite3_bind_text(s,   20, toString(c.insulation), -1, SQLITE_STATIC);
+}
+
+// Study results are stored as BLOBs of doubles in a fixed order
+static void bindDoubles(sqlite3_stmt* s, int col, const std::vector<double>& v)
+{
+    sqlite3_bind_blob(s, col, v.data(), static_cast<int>(v.size() * sizeof(double)),
+                      SQLITE_TRANSIENT);
+}
+
+// False (and `out` untouched) unless the column holds exactly n doubles
+static bool columnDoubles(sqlite3_stmt* s, int col, double* out, size_t n)
+{
+    if (sqlite3_column_type(s, col) != SQLITE_BLOB ||
+        static_cast<size_t>(sqlite3_column_bytes(s, col)) != n * sizeof(double))
+        return false;
+    std::memcpy(out, sqlite3_column_blob(s, col), n * sizeof(double));
+    return true;
+}
+
+static constexpr size_t kCalcResultDoubles = 12;
+static constexpr size_t kSolutionDoubles   = 24;   // E0, dE, Eend (re/im), peak, peakAt
+
+static std::vector<double> packResults(const CalcResults& r)
+{
+    return { r.R, r.X, r.Z, r.current, r.deltaV_V, r.deltaV_pct, r.P_MW, r.Q_Mvar,
+             r.losses_kW, r.dielLoss_kW, r.losses_pct, r.chargingA };
+}
+
+static CalcResults unpackResults(const double* d)
+{
+    CalcResults r;
+    r.R = d[0];          r.X = d[1];            r.Z = d[2];          r.current = d[3];
+    r.deltaV_V = d[4];   r.deltaV_pct = d[5];   r.P_MW = d[6];       r.Q_Mvar = d[7];
+    r.losses_kW = d[8];  r.dielLoss_kW = d[9];  r.losses_pct = d[10]; r.chargingA = d[11];
+    return r;
+}
+
+static std::vector<double> packSolution(const sheath::SectionSolution& s)
+{
+    std::vector<double> v;
+    v.reserve(kSolutionDoubles);
+    for (const auto* e : { &s.E0, &s.dE, &s.Eend })
+        for (const auto& c : *e) { v.push_back(c.real()); v.push_back(c.imag()); }
+    v.insert(v.end(), s.peak.begin(),   s.peak.end());
+    v.insert(v.end(), s.peakAt.begin(), s.peakAt.end());
+    return v;
+}
+
+static void unpackSolution(const double* d, sheath::SectionSolution& s)
+{
+    for (auto* e : { &s.E0, &s.dE, &s.Eend })
+        for (auto& c : *e) { c = { d[0], d[1] }; d += 2; }
+    for (auto& p : s.peak)   p = *d++;
+    for (auto& p : s.peakAt) p = *d++;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Statement — one use of a pooled prepared statement.
+//   Step it with step(), not sqlite3_step(): the first call starts the clock,
+//   so leasing a reader and binding are not timed.  Resets and clears
+//   bindings on destruction and, if it was stepped, records the elapsed time
+//   against the query's stats.  `stmt` may belong to any connection; the
+//   stats are shared and locked.
+// ─────────────────────────────────────────────────────────────────────────────
+class DatabaseManager::Statement
+{
+public:
+    Statement(const DatabaseManager& db, Query q)
+        : Statement(db, db.m_stmts[static_cast<size_t>(q)], q)
+    {}
+
+    Statement(const DatabaseManager& db, sqlite3_stmt* stmt, Query q)
+        : m_db   (db)
+        , m_stmt (stmt)
+        , m_query(q)
+    {}
+
+    ~Statement()
+    {
+        sqlite3_reset(m_stmt);
+        sqlite3_clear_bindings(m_stmt);
+        if (!m_stepped) return;
+
+        const double us = std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - m_start).count();
+
+        std::lock_guard<std::mutex> lock(m_db.m_statsMutex);
+        QueryStats& stats = m_db.m_stats[static_cast<size_t>(m_query)];
+        ++stats.calls;
+        stats.totalMicros += us;
+        stats.maxMicros    = std::max(stats.maxMicros, us);
+    }
+
+    Statement(const Statement&)            = delete;
+    Statement& operator=(const Statement&) = delete;
+
+    operator sqlite3_stmt*() const { return m_stmt; }
+
+    int step()
+    {
+        if (!m_stepped) {
+            m_stepped = true;
+            m_start   = std::chrono::steady_clock::now();
+        }
+        return sqlite3_step(m_stmt);
+    }
+
+private:
+    const DatabaseManager&                m_db;
+    sqlite3_stmt*                         m_stmt;
+    Query                                 m_query;
+    bool                                  m_stepped = false;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Reader — a read-only connection with its own statements, used by one
+// thread at a time.  Only the read queries are prepared; filter statements
+// are added per shape as they are needed.
+// ─────────────────────────────────────────────────────────────────────────────
+struct DatabaseManager::Reader
+{
+    static constexpr Query kQueries[] = {
+        Query::AllRecords, Query::RecordBySize,
+        Query::AvailableSizes, Query::AllManufacturers,
+        Query::StudyByName, Query::StudyScenario, Query::StudyRoute,
+        Query::StudySections, Query::StudyNames,
+    };
+
+    sqlite3*                                    db = nullptr;
+    std::array<sqlite3_stmt*, kQueryCount>      stmts{};
+    std::unordered_map<unsigned, sqlite3_stmt*> filterStmts;
+
+    Reader() = default;
+    Reader(const Reader&)            = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    ~Reader()
+    {
+        for (auto* stmt : stmts) sqlite3_finalize(stmt);
+        for (auto& entry : filterStmts) sqlite3_finalize(entry.second);
+        sqlite3_close(db);
+    }
+
+    bool open(const std::string& path)
+    {
+        if (sqlite3_open_v2(path.c_str(), &db,
+                            SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX,
+                            nullptr) != SQLITE_OK)
+            return false;
+        sqlite3_busy_timeout(db, 5000);
+
+        const auto& sql = querySql();
+        for (Query q : kQueries) {
+            const size_t i = static_cast<size_t>(q);
+            if (sqlite3_prepare_v3(db, sql[i].c_str(), -1, SQLITE_PREPARE_PERSISTENT,
+                                   &stmts[i], nullptr) != SQLITE_OK)
+                return false;
+        }
+        return true;
+    }
+
+    sqlite3_stmt* operator[](Query q) const { return stmts[static_cast<size_t>(q)]; }
+};
+
+class DatabaseManager::ReaderLease
+{
+public:
+    explicit ReaderLease(const DatabaseManager& db)
+        : m_db(db), m_reader(db.acquireReader()) {}
+    ~ReaderLease() { if (m_reader) m_db.releaseReader(m_reader); }
+
+    ReaderLease(const ReaderLease&)            = delete;
+    ReaderLease& operator=(const ReaderLease&) = delete;
+
+    explicit operator bool() const { return m_reader != nullptr; }
+    Reader*  operator->()    const { return m_reader; }
+    Reader&  operator*()     const { return *m_reader; }
+
+private:
+    const DatabaseManager& m_db;
+    Reader*                m_reader;
+};
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Lifecycle
 // ─────────────────────────────────────────────────────────────────────────────
+DatabaseManager::DatabaseManager() = default;
+
 DatabaseManager::~DatabaseManager()
 {
     close();
@@ -35,24 +332,84 @@ bool DatabaseManager::open(const std::string& path)
         m_db = nullptr;
         return false;
     }
+    m_path = path;
 
-    // Pragmas
+    // Pragmas.  WAL lets the read pool and other processes read while this
+    // connection writes; the busy timeout covers writer/checkpoint overlap.
     exec("PRAGMA journal_mode=WAL");
     exec("PRAGMA foreign_keys=ON");
+    sqlite3_busy_timeout(m_db, 5000);
 
-    if (!createSchema())  return false;
-    if (!seedIfEmpty())   return false;
+    // Any failure leaves the manager closed: isOpen() means every pooled
+    // statement is ready
+    if (!createSchema() || !prepareStatements() || !seedIfEmpty()) {
+        close();
+        return false;
+    }
     return true;
 }
 
 void DatabaseManager::close()
 {
+    {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        m_idle.clear();
+        m_readers.clear();
+    }
+
+    for (auto& stmt : m_stmts) {
+        sqlite3_finalize(stmt);
+        stmt = nullptr;
+    }
+
+    m_cache.clear();
+    m_cacheLoaded = false;
+
     if (m_db) {
         sqlite3_close(m_db);
         m_db = nullptr;
     }
 }
 
+// ─────────────────────────────────────────────────────────────────────────────
+// Read pool
+// ─────────────────────────────────────────────────────────────────────────────
+void DatabaseManager::setReadPoolSize(size_t size)
+{
+    std::lock_guard<std::mutex> lock(m_poolMutex);
+    m_readPoolSize = std::max<size_t>(size, 1);
+    m_poolFree.notify_all();
+}
+
+DatabaseManager::Reader* DatabaseManager::acquireReader() const
+{
+    std::unique_lock<std::mutex> lock(m_poolMutex);
+    if (m_path.empty() || !m_db) return nullptr;
+
+    m_poolFree.wait(lock, [&] {
+        return !m_idle.empty() || m_readers.size() < m_readPoolSize;
+    });
+    if (!m_idle.empty()) {
+        Reader* r = m_idle.back();
+        m_idle.pop_back();
+        return r;
+    }
+
+    auto r = std::make_unique<Reader>();
+    if (!r->open(m_path)) return nullptr;
+    m_readers.push_back(std::move(r));
+    return m_readers.back().get();
+}
+
+void DatabaseManager::releaseReader(Reader* r) const
+{
+    {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        m_idle.push_back(r);
+    }
+    m_poolFree.notify_one();
+}
+
 bool DatabaseManager::exec(const char* sql)
 {
     char* errMsg = nullptr;
@@ -71,6 +428,12 @@ bool DatabaseManager::exec(const char* sql)
 bool DatabaseManager::createSchema()
 {
     const char* sql = R"(
+        CREATE TABLE IF NOT EXISTS manufacturer (
+            id   INTEGER PRIMARY KEY,
+            name TEXT NOT NULL UNIQUE
+        );
+        INSERT OR IGNORE INTO manufacturer (id, name) VALUES (1, 'Generic');
+
         CREATE TABLE IF NOT EXISTS cable_size (
             id       INTEGER PRIMARY KEY AUTOINCREMENT,
             size_mm2 INTEGER NOT NULL UNIQUE
@@ -94,186 +457,811 @@ bool DatabaseManager::createSchema()
             screen_dc_resistance_20C_ohm_per_km                  REAL,
             zero_sequence_resistance_20C_ohm_per_km              REAL,
             zero_sequence_reactance_50hz_ohm_per_km              REAL,
+            manufacturer_id      INTEGER NOT NULL DEFAULT 1 REFERENCES manufacturer(id),
+            voltage_kv           REAL    NOT NULL DEFAULT 33,
+            conductor_material   TEXT    NOT NULL DEFAULT 'Cu',
+            insulation           TEXT    NOT NULL DEFAULT 'XLPE',
             FOREIGN KEY (cable_size_id) REFERENCES cable_size(id) ON DELETE CASCADE
         );
+
+        -- Bumped by every change to catalogue records (triggers below),
+        -- whoever makes it; study saves leave it alone.  Stamps the
+        -- catalogue snapshot.
+        CREATE TABLE IF NOT EXISTS catalogue_version (
+            id      INTEGER PRIMARY KEY CHECK (id = 1),
+            version INTEGER NOT NULL
+        );
+        INSERT OR IGNORE INTO catalogue_version (id, version) VALUES (1, 0);
+
+        -- Saved studies.  Results are BLOBs of doubles (host byte order);
+        -- NULL results mean "not calculated".
+        CREATE TABLE IF NOT EXISTS study (
+            id       INTEGER PRIMARY KEY,
+            name     TEXT NOT NULL UNIQUE,
+            saved_at TEXT NOT NULL DEFAULT CURRENT_TIMESTAMP
+        );
+
+        CREATE TABLE IF NOT EXISTS study_scenario (
+            study_id     INTEGER PRIMARY KEY REFERENCES study(id) ON DELETE CASCADE,
+            voltage_kv   REAL    NOT NULL,
+            power_mva    REAL    NOT NULL,
+            power_factor REAL    NOT NULL,
+            length_km    REAL    NOT NULL,
+            arrangement  INTEGER NOT NULL,
+            size_mm2     INTEGER NOT NULL,
+            input_hash   INTEGER,
+            results      BLOB
+        );
+
+        CREATE TABLE IF NOT EXISTS study_route (
+            study_id     INTEGER PRIMARY KEY REFERENCES study(id) ON DELETE CASCADE,
+            current_a    REAL    NOT NULL,
+            frequency_hz REAL    NOT NULL,
+            formula      INTEGER NOT NULL,
+            step_m       REAL    NOT NULL,
+            peaks        BLOB
+        );
+
+        CREATE TABLE IF NOT EXISTS study_section (
+            study_id   INTEGER NOT NULL REFERENCES study(id) ON DELETE CASCADE,
+            seq        INTEGER NOT NULL,
+            length_m   REAL    NOT NULL,
+            sab_mm     REAL    NOT NULL,
+            sbc_mm     REAL    NOT NULL,
+            sac_mm     REAL    NOT NULL,
+            transpose  INTEGER NOT NULL,
+            label      TEXT    NOT NULL,
+            layout     INTEGER NOT NULL,
+            input_key  INTEGER NOT NULL,   -- sheath::sectionKeys()
+            samples    INTEGER,
+            solution   BLOB,
+            PRIMARY KEY (study_id, seq)
+        ) WITHOUT ROWID;
     )";
 
-    if (!exec(sql)) {
+    // Catalogue key (also serves lookups by size) and an index for the common
+    // CableFilter fields: equality on voltage, material and insulation, then
+    // a range on DC resistance.  It is not covering — each match still reads
+    // its table row — and the ORDER BY key is s.size_mm2 from the joined size
+    // table, which no index on this table can supply, so matches are sorted
+    // after the search.
+    const char* indexes = R"(
+        DROP INDEX IF EXISTS idx_cable_electrical_data_size;
+
+        CREATE UNIQUE INDEX IF NOT EXISTS ux_cable_electrical_data_key
+            ON cable_electrical_data (cable_size_id, manufacturer_id, voltage_kv,
+                                      conductor_material, insulation);
+
+        CREATE INDEX IF NOT EXISTS idx_cable_electrical_data_filter
+            ON cable_electrical_data (voltage_kv, conductor_material, insulation,
+                                      max_dc_resistance_20C_ohm_per_km,
+                                      cable_size_id, manufacturer_id);
+    )";
+
+    // Only changes that can alter a CableRecord bump the catalogue version:
+    // electrical rows, and size rows that go or whose size actually changes
+    // (the import upsert rewrites every size row with its own value).  New
+    // size and manufacturer rows alter no record until electrical data
+    // refers to them.
+    const char* triggers = R"(
+        CREATE TRIGGER IF NOT EXISTS catalogue_changed_insert
+            AFTER INSERT ON cable_electrical_data
+            BEGIN UPDATE catalogue_version SET version = version + 1; END;
+        CREATE TRIGGER IF NOT EXISTS catalogue_changed_update
+            AFTER UPDATE ON cable_electrical_data
+            BEGIN UPDATE catalogue_version SET version = version + 1; END;
+        CREATE TRIGGER IF NOT EXISTS catalogue_changed_delete
+            AFTER DELETE ON cable_electrical_data
+            BEGIN UPDATE catalogue_version SET version = version + 1; END;
+        CREATE TRIGGER IF NOT EXISTS catalogue_changed_size
+            AFTER UPDATE OF size_mm2 ON cable_size
+            WHEN OLD.size_mm2 IS NOT NEW.size_mm2
+            BEGIN UPDATE catalogue_version SET version = version + 1; END;
+        CREATE TRIGGER IF NOT EXISTS catalogue_changed_size_delete
+            AFTER DELETE ON cable_size
+            BEGIN UPDATE catalogue_version SET version = version + 1; END;
+    )";
+
+    if (!exec(sql) || !migrateSchema() || !exec(indexes) || !exec(triggers)) {
         m_error = "Schema creation failed: " + m_error;
         return false;
     }
     return true;
 }
 
+// Databases created before the catalogue columns existed are upgraded in
+// place; their rows take the defaults, which describe the built-in data.
+bool DatabaseManager::migrateSchema()
+{
+    sqlite3_stmt* stmt = nullptr;
+    sqlite3_prepare_v2(m_db,
+        "SELECT COUNT(*) FROM pragma_table_info('cable_electrical_data') "
+        "WHERE name = 'voltage_kv'", -1, &stmt, nullptr);
+    int present = 0;
+    if (sqlite3_step(stmt) == SQLITE_ROW)
+        present = sqlite3_column_int(stmt, 0);
+    sqlite3_finalize(stmt);
+
+    if (present) return true;
+
+    // ADD COLUMN cannot carry a REFERENCES clause with a non-NULL default
+    // while foreign keys are on, so migrated databases go without it.
+    return exec(R"(
+        BEGIN;
+        ALTER TABLE cable_electrical_data ADD COLUMN manufacturer_id    INTEGER NOT NULL DEFAULT 1;
+        ALTER TABLE cable_electrical_data ADD COLUMN voltage_kv         REAL    NOT NULL DEFAULT 33;
+        ALTER TABLE cable_electrical_data ADD COLUMN conductor_material TEXT    NOT NULL DEFAULT 'Cu';
+        ALTER TABLE cable_electrical_data ADD COLUMN insulation         TEXT    NOT NULL DEFAULT 'XLPE';
+        COMMIT;
+    )");
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Statement pool
+// ─────────────────────────────────────────────────────────────────────────────
+const std::array<std::string, DatabaseManager::kQueryCount>& DatabaseManager::querySql()
+{
+    static const std::array<std::string, kQueryCount> sql = [] {
+        std::array<std::string, kQueryCount> out;
+        auto at = [&](Query q) -> std::string& { return out[static_cast<size_t>(q)]; };
+
+        at(Query::DataVersion)    = "PRAGMA data_version";
+        at(Query::CatalogueVersion) = "SELECT version FROM catalogue_version";
+        at(Query::CountSizes)     = "SELECT COUNT(*) FROM cable_size";
+        at(Query::InsertSize)     = "INSERT INTO cable_size (size_mm2) VALUES (?)";
+        at(Query::InsertElectrical) = R"(
+            INSERT INTO cable_electrical_data (
+                cable_size_id,
+                max_dc_resistance_20C_ohm_per_km,
+                ac_resistance_50hz_90C_trefoil_touching_ohm_per_km,
+                ac_resistance_50hz_90C_flat_touching_ohm_per_km,
+                ac_resistance_50hz_90C_flat_spaced_ohm_per_km,
+                inductive_reactance_50hz_90C_trefoil_touching_ohm_per_km,
+                inductive_reactance_50hz_90C_flat_touching_ohm_per_km,
+                inductive_reactance_50hz_90C_flat_spaced_ohm_per_km,
+                insulation_resistance_20C_Mohm_km,
+                conductor_to_screen_capacitance_uF_per_km,
+                charging_current_per_phase_A_per_km,
+                dielectric_loss_per_phase_W_per_km,
+                max_dielectric_stress_kV_per_mm,
+                screen_dc_resistance_20C_ohm_per_km,
+                zero_sequence_resistance_20C_ohm_per_km,
+                zero_sequence_reactance_50hz_ohm_per_km,
+                manufacturer_id,
+                voltage_kv,
+                conductor_material,
+                insulation
+            ) VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?)
+            ON CONFLICT (cable_size_id, manufacturer_id, voltage_kv,
+                         conductor_material, insulation) DO UPDATE SET
+                max_dc_resistance_20C_ohm_per_km                         = excluded.max_dc_resistance_20C_ohm_per_km,
+                ac_resistance_50hz_90C_trefoil_touching_ohm_per_km       = excluded.ac_resistance_50hz_90C_trefoil_touching_ohm_per_km,
+                ac_resistance_50hz_90C_flat_touching_ohm_per_km          = excluded.ac_resistance_50hz_90C_flat_touching_ohm_per_km,
+                ac_resistance_50hz_90C_flat_spaced_ohm_per_km            = excluded.ac_resistance_50hz_90C_flat_spaced_ohm_per_km,
+                inductive_reactance_50hz_90C_trefoil_touching_ohm_per_km = excluded.inductive_reactance_50hz_90C_trefoil_touching_ohm_per_km,
+                inductive_reactance_50hz_90C_flat_touching_ohm_per_km    = excluded.inductive_reactance_50hz_90C_flat_touching_ohm_per_km,
+                inductive_reactance_50hz_90C_flat_spaced_ohm_per_km      = excluded.inductive_reactance_50hz_90C_flat_spaced_ohm_per_km,
+                insulation_resistance_20C_Mohm_km                        = excluded.insulation_resistance_20C_Mohm_km,
+                conductor_to_screen_capacitance_uF_per_km                = excluded.conductor_to_screen_capacitance_uF_per_km,
+                charging_current_per_phase_A_per_km                      = excluded.charging_current_per_phase_A_per_km,
+                dielectric_loss_per_phase_W_per_km                       = excluded.dielectric_loss_per_phase_W_per_km,
+                max_dielectric_stress_kV_per_mm                          = excluded.max_dielectric_stress_kV_per_mm,
+                screen_dc_resistance_20C_ohm_per_km                      = excluded.screen_dc_resistance_20C_ohm_per_km,
+                zero_sequence_resistance_20C_ohm_per_km                  = excluded.zero_sequence_resistance_20C_ohm_per_km,
+                zero_sequence_reactance_50hz_ohm_per_km                  = excluded.zero_sequence_reactance_50hz_ohm_per_km
+        )";
+        at(Query::AllRecords)     = std::string(kRecordSelect) + kRecordOrder;
+        at(Query::RecordBySize)   = std::string(kRecordSelect) + "WHERE s.size_mm2 = ? "
+                                  + kRecordOrder + " LIMIT 1";
+        at(Query::AvailableSizes) = "SELECT size_mm2 FROM cable_size ORDER BY size_mm2";
+        at(Query::Synchronous)    = "PRAGMA synchronous";
+        at(Query::CacheSize)      = "PRAGMA cache_size";
+        at(Query::UpsertSize)     = "INSERT INTO cable_size (size_mm2) VALUES (?) "
+                                    "ON CONFLICT (size_mm2) DO UPDATE SET size_mm2 = excluded.size_mm2 "
+                                    "RETURNING id";
+        at(Query::UpsertManufacturer) = "INSERT INTO manufacturer (name) VALUES (?) "
+                                        "ON CONFLICT (name) DO UPDATE SET name = excluded.name "
+                                        "RETURNING id";
+        at(Query::AllManufacturers)   = "SELECT id, name FROM manufacturer ORDER BY id";
+
+        at(Query::DeleteStudy)    = "DELETE FROM study WHERE name = ?";
+        at(Query::InsertStudy)    = "INSERT INTO study (name) VALUES (?) RETURNING id";
+        at(Query::InsertScenario) = "INSERT INTO study_scenario VALUES (?,?,?,?,?,?,?,?,?)";
+        at(Query::InsertRoute)    = "INSERT INTO study_route VALUES (?,?,?,?,?,?)";
+        at(Query::InsertSection)  = "INSERT INTO study_section VALUES (?,?,?,?,?,?,?,?,?,?,?,?)";
+        at(Query::StudyByName)    = "SELECT id FROM study WHERE name = ?";
+        at(Query::StudyScenario)  = "SELECT voltage_kv, power_mva, power_factor, length_km, "
+                                    "arrangement, size_mm2, input_hash, results "
+                                    "FROM study_scenario WHERE study_id = ?";
+        at(Query::StudyRoute)     = "SELECT current_a, frequency_hz, formula, step_m, peaks "
+                                    "FROM study_route WHERE study_id = ?";
+        at(Query::StudySections)  = "SELECT length_m, sab_mm, sbc_mm, sac_mm, transpose, label, "
+                                    "layout, input_key, samples, solution "
+                                    "FROM study_section WHERE study_id = ? ORDER BY seq";
+        at(Query::StudyNames)     = "SELECT name FROM study ORDER BY saved_at DESC, id DESC";
+        return out;
+    }();
+    return sql;
+}
+
+bool DatabaseManager::prepareStatements()
+{
+    const auto& sql = querySql();
+    for (size_t i = 0; i < kQueryCount; ++i) {
+        if (sql[i].empty()) continue;   // Filter: prepared per shape in forEach()
+
+        // PERSISTENT: these live for the whole connection
+        if (sqlite3_prepare_v3(m_db, sql[i].c_str(), -1, SQLITE_PREPARE_PERSISTENT,
+                               &m_stmts[i], nullptr) != SQLITE_OK) {
+            m_error = "Prepare failed: " + sqliteError(m_db);
+            return false;
+        }
+    }
+    resetQueryStats();
+    return true;
+}
+
+DatabaseManager::QueryStats DatabaseManager::queryStats(Query q) const
+{
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    return m_stats[static_cast<size_t>(q)];
+}
+
+void DatabaseManager::resetQueryStats()
+{
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    m_stats = {};
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Seeding
 // ─────────────────────────────────────────────────────────────────────────────
 bool DatabaseManager::seedIfEmpty()
 {
     // Check row count
-    sqlite3_stmt* stmt = nullptr;
-    sqlite3_prepare_v2(m_db, "SELECT COUNT(*) FROM cable_size", -1, &stmt, nullptr);
     int count = 0;
-    if (sqlite3_step(stmt) == SQLITE_ROW)
-        count = sqlite3_column_int(stmt, 0);
-    sqlite3_finalize(stmt);
+    {
+        Statement stmt(*this, Query::CountSizes);
+        if (stmt.step() == SQLITE_ROW)
+            count = sqlite3_column_int(stmt, 0);
+    }
 
     if (count > 0) return true;  // already seeded
 
     exec("BEGIN TRANSACTION");
 
-    sqlite3_stmt* insSize  = nullptr;
-    sqlite3_stmt* insElec  = nullptr;
-
-    sqlite3_prepare_v2(m_db,
-        "INSERT INTO cable_size (size_mm2) VALUES (?)",
-        -1, &insSize, nullptr);
-
-    sqlite3_prepare_v2(m_db, R"(
-        INSERT INTO cable_electrical_data (
-            cable_size_id,
-            max_dc_resistance_20C_ohm_per_km,
-            ac_resistance_50hz_90C_trefoil_touching_ohm_per_km,
-            ac_resistance_50hz_90C_flat_touching_ohm_per_km,
-            ac_resistance_50hz_90C_flat_spaced_ohm_per_km,
-            inductive_reactance_50hz_90C_trefoil_touching_ohm_per_km,
-            inductive_reactance_50hz_90C_flat_touching_ohm_per_km,
-            inductive_reactance_50hz_90C_flat_spaced_ohm_per_km,
-            insulation_resistance_20C_Mohm_km,
-            conductor_to_screen_capacitance_uF_per_km,
-            charging_current_per_phase_A_per_km,
-            dielectric_loss_per_phase_W_per_km,
-            max_dielectric_stress_kV_per_mm,
-            screen_dc_resistance_20C_ohm_per_km,
-            zero_sequence_resistance_20C_ohm_per_km,
-            zero_sequence_reactance_50hz_ohm_per_km
-        ) VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?)
-    )", -1, &insElec, nullptr);
-
-    auto bindReal = [](sqlite3_stmt* s, int col, double v) {
-        if (v < 0)
-            sqlite3_bind_null(s, col);
-        else
-            sqlite3_bind_double(s, col, v);
-    };
-
     for (const auto& c : cableDatabase()) {
         // Insert size row
-        sqlite3_bind_int(insSize, 1, c.sizeMm2);
-        sqlite3_step(insSize);
-        sqlite3_int64 sizeId = sqlite3_last_insert_rowid(m_db);
-        sqlite3_reset(insSize);
+        sqlite3_int64 sizeId = 0;
+        {
+            Statement insSize(*this, Query::InsertSize);
+            sqlite3_bind_int(insSize, 1, c.sizeMm2);
+            insSize.step();
+            sizeId = sqlite3_last_insert_rowid(m_db);
+        }
 
         // Insert electrical row
-        sqlite3_bind_int64(insElec,  1, sizeId);
-        sqlite3_bind_double(insElec, 2,  c.maxDcResistance20C);
-        sqlite3_bind_double(insElec, 3,  c.acResistanceTrefoilTouching);
-        sqlite3_bind_double(insElec, 4,  c.acResistanceFlatTouching);
-        bindReal(insElec,            5,  c.acResistanceFlatSpaced);
-        sqlite3_bind_double(insElec, 6,  c.inductiveReactanceTrefoilTouching);
-        sqlite3_bind_double(insElec, 7,  c.inductiveReactanceFlatTouching);
-        sqlite3_bind_double(insElec, 8,  c.inductiveReactanceFlatSpaced);
-        sqlite3_bind_double(insElec, 9,  c.insulationResistance20C);
-        sqlite3_bind_double(insElec, 10, c.conductorToScreenCapacitance);
-        sqlite3_bind_double(insElec, 11, c.chargingCurrentPerPhase);
-        sqlite3_bind_double(insElec, 12, c.dielectricLossPerPhase);
-        sqlite3_bind_double(insElec, 13, c.maxDielectricStress);
-        sqlite3_bind_double(insElec, 14, c.screenDcResistance20C);
-        sqlite3_bind_double(insElec, 15, c.zeroSequenceResistance20C);
-        sqlite3_bind_double(insElec, 16, c.zeroSequenceReactance50Hz);
-        sqlite3_step(insElec);
-        sqlite3_reset(insElec);
-    }
-
-    sqlite3_finalize(insSize);
-    sqlite3_finalize(insElec);
+        Statement insElec(*this, Query::InsertElectrical);
+        bindElectrical(insElec, sizeId, c);
+        insElec.step();
+    }
+
     exec("COMMIT");
     return true;
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-// Queries
+// Bulk import
 // ─────────────────────────────────────────────────────────────────────────────
-std::vector<CableRecord> DatabaseManager::allRecords() const
+bool DatabaseManager::importRecords(const std::vector<CableRecord>& records,
+                                    const ImportProgress& progress)
 {
-    std::vector<CableRecord> out;
-    if (!m_db) return out;
+    if (!m_db) {
+        m_error = "Database is not open";
+        return false;
+    }
 
-    const char* sql = R"(
-        SELECT
-            s.size_mm2,
-            e.max_dc_resistance_20C_ohm_per_km,
-            e.ac_resistance_50hz_90C_trefoil_touching_ohm_per_km,
-            e.ac_resistance_50hz_90C_flat_touching_ohm_per_km,
-            e.ac_resistance_50hz_90C_flat_spaced_ohm_per_km,
-            e.inductive_reactance_50hz_90C_trefoil_touching_ohm_per_km,
-            e.inductive_reactance_50hz_90C_flat_touching_ohm_per_km,
-            e.inductive_reactance_50hz_90C_flat_spaced_ohm_per_km,
-            e.insulation_resistance_20C_Mohm_km,
-            e.conductor_to_screen_capacitance_uF_per_km,
-            e.charging_current_per_phase_A_per_km,
-            e.dielectric_loss_per_phase_W_per_km,
-            e.max_dielectric_stress_kV_per_mm,
-            e.screen_dc_resistance_20C_ohm_per_km,
-            e.zero_sequence_resistance_20C_ohm_per_km,
-            e.zero_sequence_reactance_50hz_ohm_per_km
-        FROM cable_electrical_data e
-        JOIN cable_size s ON s.id = e.cable_size_id
-        ORDER BY s.size_mm2
-    )";
+    // Nothing needs to reach the disk before the final COMMIT, so relax
+    // syncing and widen the page cache for the load, then restore the
+    // connection's settings.
+    auto pragmaValue = [&](Query q, int fallback) {
+        Statement stmt(*this, q);
+        return (stmt.step() == SQLITE_ROW) ? sqlite3_column_int(stmt, 0) : fallback;
+    };
+    const int prevSync  = pragmaValue(Query::Synchronous, 2);      // FULL
+    const int prevCache = pragmaValue(Query::CacheSize,   -2000);  // SQLite default
+    exec("PRAGMA synchronous=OFF");
+    exec("PRAGMA cache_size=-65536");   // 64 MiB
 
-    sqlite3_stmt* stmt = nullptr;
-    if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) != SQLITE_OK)
-        return out;
+    bool ok = exec("BEGIN IMMEDIATE");
+    const size_t total = records.size();
 
-    auto colReal = [&](int col) -> double {
-        if (sqlite3_column_type(stmt, col) == SQLITE_NULL) return -1.0;
-        return sqlite3_column_double(stmt, col);
+    auto step = [&](Statement& stmt, int expected, size_t row) {
+        if (stmt.step() == expected) return true;
+        m_error = "Import failed at record " + std::to_string(row + 1) + ": "
+                + sqliteError(m_db);
+        return false;
     };
 
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-        CableRecord r;
-        r.sizeMm2                          = sqlite3_column_int(stmt, 0);
-        r.maxDcResistance20C               = colReal(1);
-        r.acResistanceTrefoilTouching      = colReal(2);
-        r.acResistanceFlatTouching         = colReal(3);
-        r.acResistanceFlatSpaced           = colReal(4);
-        r.inductiveReactanceTrefoilTouching = colReal(5);
-        r.inductiveReactanceFlatTouching   = colReal(6);
-        r.inductiveReactanceFlatSpaced     = colReal(7);
-        r.insulationResistance20C          = colReal(8);
-        r.conductorToScreenCapacitance     = colReal(9);
-        r.chargingCurrentPerPhase          = colReal(10);
-        r.dielectricLossPerPhase           = colReal(11);
-        r.maxDielectricStress              = colReal(12);
-        r.screenDcResistance20C            = colReal(13);
-        r.zeroSequenceResistance20C        = colReal(14);
-        r.zeroSequenceReactance50Hz        = colReal(15);
-        out.push_back(r);
+    for (size_t i = 0; ok && i < total; ++i) {
+        const CableRecord& c = records[i];
+
+        sqlite3_int64 sizeId = 0;
+        {
+            Statement upsert(*this, Query::UpsertSize);
+            sqlite3_bind_int(upsert, 1, c.sizeMm2);
+            ok = step(upsert, SQLITE_ROW, i);
+            if (ok) sizeId = sqlite3_column_int64(upsert, 0);
+        }
+        if (ok) {
+            Statement ins(*this, Query::InsertElectrical);
+            bindElectrical(ins, sizeId, c);
+            ok = step(ins, SQLITE_DONE, i);
+        }
+
+        if (ok && progress && ((i + 1) % 4096 == 0 || i + 1 == total))
+            progress(i + 1, total);
     }
 
-    sqlite3_finalize(stmt);
+    if (ok) ok = exec("COMMIT");
+    if (!ok) {
+        const std::string err = m_error;
+        exec("ROLLBACK");
+        m_error = err;
+    }
+
+    exec(("PRAGMA synchronous=" + std::to_string(prevSync)).c_str());
+    exec(("PRAGMA cache_size="  + std::to_string(prevCache)).c_str());
+    return ok;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Queries
+// ─────────────────────────────────────────────────────────────────────────────
+long long DatabaseManager::catalogueVersion() const
+{
+    if (!m_db) return -1;
+    Statement stmt(*this, Query::CatalogueVersion);
+    return (stmt.step() == SQLITE_ROW) ? sqlite3_column_int64(stmt, 0) : -1;
+}
+
+long long DatabaseManager::storedCatalogueVersion(const std::string& path)
+{
+    sqlite3* db = nullptr;
+    long long version = -1;
+    if (sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READONLY, nullptr) == SQLITE_OK) {
+        sqlite3_busy_timeout(db, 5000);
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(db, querySql()[static_cast<size_t>(Query::CatalogueVersion)].c_str(),
+                               -1, &stmt, nullptr) == SQLITE_OK &&
+            sqlite3_step(stmt) == SQLITE_ROW)
+            version = sqlite3_column_int64(stmt, 0);
+        sqlite3_finalize(stmt);
+    }
+    sqlite3_close(db);   // Also after a failed open
+    return version;
+}
+
+std::vector<CableRecord> DatabaseManager::allRecords() const
+{
+    return records();
+}
+
+std::vector<CableRecord> DatabaseManager::loadRecords() const
+{
+    std::vector<CableRecord> out;
+    if (!m_db) return out;
+
+    Statement stmt(*this, Query::AllRecords);
+    while (stmt.step() == SQLITE_ROW)
+        out.push_back(readRecord(stmt));
     return out;
 }
 
 CableRecord DatabaseManager::recordBySize(int sizeMm2) const
 {
-    for (const auto& r : allRecords())
-        if (r.sizeMm2 == sizeMm2) return r;
-    return {};
+    const CableRecord* r = findRecord(sizeMm2);
+    return r ? *r : CableRecord{};
 }
 
 std::vector<int> DatabaseManager::availableSizes() const
 {
     std::vector<int> out;
-    if (!m_db) return out;
+    ReaderLease reader(*this);
+    if (!reader) return out;
 
-    sqlite3_stmt* stmt = nullptr;
-    sqlite3_prepare_v2(m_db,
-        "SELECT size_mm2 FROM cable_size ORDER BY size_mm2",
-        -1, &stmt, nullptr);
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    Statement stmt(*this, (*reader)[Query::AvailableSizes], Query::AvailableSizes);
+    while (stmt.step() == SQLITE_ROW)
         out.push_back(sqlite3_column_int(stmt, 0));
-    sqlite3_finalize(stmt);
     return out;
 }
+
+bool DatabaseManager::fetchBySize(int sizeMm2, CableRecord& out) const
+{
+    ReaderLease reader(*this);
+    if (!reader) return false;
+
+    Statement stmt(*this, (*reader)[Query::RecordBySize], Query::RecordBySize);
+    sqlite3_bind_int(stmt, 1, sizeMm2);
+    if (stmt.step() != SQLITE_ROW) return false;
+    out = readRecord(stmt);
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Filtered queries
+//   One statement per filter shape (which fields are set), prepared on first
+//   use.  Parameters are numbered by field so every shape binds the same way.
+// ─────────────────────────────────────────────────────────────────────────────
+size_t DatabaseManager::forEach(const CableFilter& f, const RecordVisitor& visit,
+                                size_t limit) const
+{
+    ReaderLease reader(*this);
+    if (!reader) return 0;
+
+    const unsigned shape =
+        (f.manufacturerId  ? 1u << 0 : 0u) | (f.voltageKV  ? 1u << 1 : 0u) |
+        (f.material        ? 1u << 2 : 0u) | (f.insulation ? 1u << 3 : 0u) |
+        (f.minSizeMm2      ? 1u << 4 : 0u) | (f.maxSizeMm2 ? 1u << 5 : 0u) |
+        (f.maxDcResistance ? 1u << 6 : 0u);
+
+    sqlite3_stmt*& stmt = reader->filterStmts[shape];
+    if (!stmt) {
+        std::string sql = std::string(kRecordSelect) + "WHERE 1";
+        if (f.manufacturerId)  sql += " AND e.manufacturer_id = ?1";
+        if (f.voltageKV)       sql += " AND e.voltage_kv = ?2";
+        if (f.material)        sql += " AND e.conductor_material = ?3";
+        if (f.insulation)      sql += " AND e.insulation = ?4";
+        if (f.minSizeMm2)      sql += " AND s.size_mm2 >= ?5";
+        if (f.maxSizeMm2)      sql += " AND s.size_mm2 <= ?6";
+        if (f.maxDcResistance) sql += " AND e.max_dc_resistance_20C_ohm_per_km <= ?7";
+        sql += std::string(" ") + kRecordOrder;
+
+        if (sqlite3_prepare_v3(reader->db, sql.c_str(), -1, SQLITE_PREPARE_PERSISTENT,
+                               &stmt, nullptr) != SQLITE_OK) {
+            sqlite3_finalize(stmt);
+            reader->filterStmts.erase(shape);
+            return 0;
+        }
+    }
+
+    Statement q(*this, stmt, Query::Filter);
+    if (f.manufacturerId) sqlite3_bind_int(q, 1, *f.manufacturerId);
+    if (f.voltageKV)       sqlite3_bind_double(q, 2, *f.voltageKV);
+    if (f.material)        sqlite3_bind_text(q, 3, toString(*f.material),   -1, SQLITE_STATIC);
+    if (f.insulation)      sqlite3_bind_text(q, 4, toString(*f.insulation), -1, SQLITE_STATIC);
+    if (f.minSizeMm2)      sqlite3_bind_int(q, 5, *f.minSizeMm2);
+    if (f.maxSizeMm2)      sqlite3_bind_int(q, 6, *f.maxSizeMm2);
+    if (f.maxDcResistance) sqlite3_bind_double(q, 7, *f.maxDcResistance);
+
+    size_t n = 0;
+    while ((limit == 0 || n < limit) && q.step() == SQLITE_ROW) {
+        visit(readRecord(q));
+        ++n;
+    }
+    return n;
+}
+
+std::vector<CableRecord> DatabaseManager::query(const CableFilter& filter,
+                                                size_t limit) const
+{
+    std::vector<CableRecord> out;
+    forEach(filter, [&](const CableRecord& r) { out.push_back(r); }, limit);
+    return out;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Manufacturers
+// ─────────────────────────────────────────────────────────────────────────────
+int DatabaseManager::manufacturerId(const std::string& name)
+{
+    if (!m_db) return 0;
+
+    Statement stmt(*this, Query::UpsertManufacturer);
+    sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+    if (stmt.step() != SQLITE_ROW) {
+        m_error = sqliteError(m_db);
+        return 0;
+    }
+    return sqlite3_column_int(stmt, 0);
+}
+
+std::vector<std::pair<int, std::string>> DatabaseManager::manufacturers() const
+{
+    std::vector<std::pair<int, std::string>> out;
+    ReaderLease reader(*this);
+    if (!reader) return out;
+
+    Statement stmt(*this, (*reader)[Query::AllManufacturers], Query::AllManufacturers);
+    while (stmt.step() == SQLITE_ROW) {
+        const unsigned char* name = sqlite3_column_text(stmt, 1);
+        out.emplace_back(sqlite3_column_int(stmt, 0),
+                         name ? reinterpret_cast<const char*>(name) : "");
+    }
+    return out;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Studies
+// ─────────────────────────────────────────────────────────────────────────────
+bool DatabaseManager::saveStudy(const Study& study)
+{
+    if (!m_db) {
+        m_error = "Database is not open";
+        return false;
+    }
+
+    const auto& route  = study.sheath.route;
+    const auto  keys   = sheath::sectionKeys(study.sheath);
+    const auto& res    = study.sheathResults;
+    const bool  solved = res.valid && study.sectionKeys == keys
+                      && res.sections.size() == route.size();
+
+    auto step = [&](Statement& stmt, int expected) {
+        if (stmt.step() == expected) return true;
+        m_error = "Saving study failed: " + sqliteError(m_db);
+        return false;
+    };
+
+    bool ok = exec("BEGIN IMMEDIATE");
+    if (ok) {
+        Statement del(*this, Query::DeleteStudy);
+        sqlite3_bind_text(del, 1, study.name.c_str(), -1, SQLITE_TRANSIENT);
+        ok = step(del, SQLITE_DONE);
+    }
+
+    sqlite3_int64 id = 0;
+    if (ok) {
+        Statement ins(*this, Query::InsertStudy);
+        sqlite3_bind_text(ins, 1, study.name.c_str(), -1, SQLITE_TRANSIENT);
+        ok = step(ins, SQLITE_ROW);
+        if (ok) id = sqlite3_column_int64(ins, 0);
+    }
+
+    if (ok) {
+        const SystemParams& p = study.system;
+        Statement ins(*this, Query::InsertScenario);
+        sqlite3_bind_int64 (ins, 1, id);
+        sqlite3_bind_double(ins, 2, p.voltageKV);
+        sqlite3_bind_double(ins, 3, p.powerMVA);
+        sqlite3_bind_double(ins, 4, p.powerFactor);
+        sqlite3_bind_double(ins, 5, p.lengthKm);
+        sqlite3_bind_int   (ins, 6, static_cast<int>(p.arrangement));
+        sqlite3_bind_int   (ins, 7, p.sizeMm2);
+        if (study.systemSolved) {
+            sqlite3_bind_int64(ins, 8, static_cast<sqlite3_int64>(study.systemKey));
+            bindDoubles(ins, 9, packResults(study.systemResults));
+        }
+        ok = step(ins, SQLITE_DONE);
+    }
+
+    if (ok) {
+        const sheath::SheathParams& p = study.sheath;
+        Statement ins(*this, Query::InsertRoute);
+        sqlite3_bind_int64 (ins, 1, id);
+        sqlite3_bind_double(ins, 2, p.current_A);
+        sqlite3_bind_double(ins, 3, p.frequency_Hz);
+        sqlite3_bind_int   (ins, 4, static_cast<int>(p.formula));
+        sqlite3_bind_double(ins, 5, p.step_m);
+        if (solved)
+            bindDoubles(ins, 6, { res.maxVoltage_A,  res.maxVoltage_B,  res.maxVoltage_C,
+                                  res.maxLocation_A, res.maxLocation_B, res.maxLocation_C });
+        ok = step(ins, SQLITE_DONE);
+    }
+
+    for (size_t i = 0; ok && i < route.size(); ++i) {
+        const auto& sec = route[i];
+        Statement ins(*this, Query::InsertSection);
+        sqlite3_bind_int64 (ins, 1,  id);
+        sqlite3_bind_int   (ins, 2,  static_cast<int>(i));
+        sqlite3_bind_double(ins, 3,  sec.length_m);
+        sqlite3_bind_double(ins, 4,  sec.Sab_mm);
+        sqlite3_bind_double(ins, 5,  sec.Sbc_mm);
+        sqlite3_bind_double(ins, 6,  sec.Sac_mm);
+        sqlite3_bind_int   (ins, 7,  sec.transpose ? 1 : 0);
+        sqlite3_bind_text  (ins, 8,  sec.label.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int   (ins, 9,  i < study.sectionLayouts.size() ? study.sectionLayouts[i] : 0);
+        sqlite3_bind_int64 (ins, 10, static_cast<sqlite3_int64>(keys[i]));
+        if (solved) {
+            sqlite3_bind_int(ins, 11, res.sections[i].samples);
+            bindDoubles(ins, 12, packSolution(res.sections[i]));
+        }
+        ok = step(ins, SQLITE_DONE);
+    }
+
+    if (ok) ok = exec("COMMIT");
+    if (!ok) {
+        const std::string err = m_error;
+        exec("ROLLBACK");
+        m_error = err;
+    }
+    return ok;
+}
+
+bool DatabaseManager::loadStudy(const std::string& name, Study& out) const
+{
+    m_error.clear();
+    ReaderLease reader(*this);
+    if (!reader) return false;
+
+    // One read transaction, so a concurrent save is seen whole or not at all
+    sqlite3_exec(reader->db, "BEGIN", nullptr, nullptr, nullptr);
+    struct EndRead {
+        sqlite3* db;
+        ~EndRead() { sqlite3_exec(db, "COMMIT", nullptr, nullptr, nullptr); }
+    } endRead{ reader->db };
+
+    sqlite3_int64 id = 0;
+    {
+        Statement stmt(*this, (*reader)[Query::StudyByName], Query::StudyByName);
+        sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+        if (stmt.step() != SQLITE_ROW) return false;
+        id = sqlite3_column_int64(stmt, 0);
+    }
+
+    Study study;
+    study.name = name;
+
+    {
+        Statement stmt(*this, (*reader)[Query::StudyScenario], Query::StudyScenario);
+        sqlite3_bind_int64(stmt, 1, id);
+        if (stmt.step() == SQLITE_ROW) {
+            SystemParams& p = study.system;
+            p.voltageKV   = sqlite3_column_double(stmt, 0);
+            p.powerMVA    = sqlite3_column_double(stmt, 1);
+            p.powerFactor = sqlite3_column_double(stmt, 2);
+            p.lengthKm    = sqlite3_column_double(stmt, 3);
+            const int arrangement = sqlite3_column_int(stmt, 4);
+            if (arrangement < static_cast<int>(Arrangement::TrefoilTouching) ||
+                arrangement > static_cast<int>(Arrangement::FlatSpaced)) {
+                m_error = "Study '" + name + "': unknown arrangement code "
+                        + std::to_string(arrangement);
+                return false;
+            }
+            p.arrangement = static_cast<Arrangement>(arrangement);
+            p.sizeMm2     = sqlite3_column_int(stmt, 5);
+
+            double d[kCalcResultDoubles];
+            if (sqlite3_column_type(stmt, 6) != SQLITE_NULL &&
+                columnDoubles(stmt, 7, d, kCalcResultDoubles)) {
+                study.systemSolved  = true;
+                study.systemKey     = static_cast<std::uint64_t>(sqlite3_column_int64(stmt, 6));
+                study.systemResults = unpackResults(d);
+            }
+        }
+    }
+
+    sheath::SheathResults& res = study.sheathResults;
+    bool solved = false;
+    {
+        Statement stmt(*this, (*reader)[Query::StudyRoute], Query::StudyRoute);
+        sqlite3_bind_int64(stmt, 1, id);
+        if (stmt.step() == SQLITE_ROW) {
+            sheath::SheathParams& p = study.sheath;
+            p.current_A    = sqlite3_column_double(stmt, 0);
+            p.frequency_Hz = sqlite3_column_double(stmt, 1);
+            const int formula = sqlite3_column_int(stmt, 2);
+            if (formula < static_cast<int>(sheath::SheathParams::Formula::SIMPLIFIED) ||
+                formula > static_cast<int>(sheath::SheathParams::Formula::FULL)) {
+                m_error = "Study '" + name + "': unknown formula code "
+                        + std::to_string(formula);
+                return false;
+            }
+            p.formula      = static_cast<sheath::SheathParams::Formula>(formula);
+            p.step_m       = sqlite3_column_double(stmt, 3);
+
+            double d[6];
+            solved = columnDoubles(stmt, 4, d, 6);
+            if (solved) {
+                res.maxVoltage_A  = d[0];  res.maxVoltage_B  = d[1];  res.maxVoltage_C  = d[2];
+                res.maxLocation_A = d[3];  res.maxLocation_B = d[4];  res.maxLocation_C = d[5];
+            }
+        }
+    }
+
+    // Section positions are rebuilt with the same accumulation as the solver
+    {
+        Statement stmt(*this, (*reader)[Query::StudySections], Query::StudySections);
+        sqlite3_bind_int64(stmt, 1, id);
+
+        double start       = 0.0;
+        int    firstSample = 1;
+        while (stmt.step() == SQLITE_ROW) {
+            sheath::RouteSection sec;
+            sec.length_m  = sqlite3_column_double(stmt, 0);
+            sec.Sab_mm    = sqlite3_column_double(stmt, 1);
+            sec.Sbc_mm    = sqlite3_column_double(stmt, 2);
+            sec.Sac_mm    = sqlite3_column_double(stmt, 3);
+            sec.transpose = sqlite3_column_int(stmt, 4) != 0;
+            const unsigned char* label = sqlite3_column_text(stmt, 5);
+            sec.label     = label ? reinterpret_cast<const char*>(label) : "";
+
+            const bool first = study.sheath.route.empty();
+            study.sheath.route.push_back(sec);
+            study.sectionLayouts.push_back(sqlite3_column_int(stmt, 6));
+            study.sectionKeys.push_back(static_cast<std::uint64_t>(sqlite3_column_int64(stmt, 7)));
+
+            double d[kSolutionDoubles];
+            if (solved && sqlite3_column_type(stmt, 8) != SQLITE_NULL &&
+                columnDoubles(stmt, 9, d, kSolutionDoubles)) {
+                sheath::SectionSolution sol;
+                sol.start_m     = start;
+                sol.length_m    = sec.length_m;
+                sol.firstSample = firstSample;
+                sol.samples     = sqlite3_column_int(stmt, 8);
+                unpackSolution(d, sol);
+                if (!first && sec.transpose) res.minorBoundaries.push_back(start);
+                res.sections.push_back(sol);
+                firstSample += sol.samples;
+            } else {
+                solved = false;
+            }
+            start += sec.length_m;
+        }
+        res.totalLength = start;
+    }
+    res.valid = solved && !res.sections.empty();
+    if (!res.valid) res = {};
+
+    out = std::move(study);
+    return true;
+}
+
+std::vector<std::string> DatabaseManager::studyNames() const
+{
+    std::vector<std::string> out;
+    ReaderLease reader(*this);
+    if (!reader) return out;
+
+    Statement stmt(*this, (*reader)[Query::StudyNames], Query::StudyNames);
+    while (stmt.step() == SQLITE_ROW) {
+        const unsigned char* name = sqlite3_column_text(stmt, 0);
+        out.emplace_back(name ? reinterpret_cast<const char*>(name) : "");
+    }
+    return out;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Record cache
+// ─────────────────────────────────────────────────────────────────────────────
+void DatabaseManager::refreshCache() const
+{
+    if (!m_db) {
+        m_cache.clear();
+        m_cacheLoaded = false;
+        return;
+    }
+
+    // data_version moves when another connection commits; total_changes
+    // counts writes made through this one.  Neither query allocates.
+    long long version = 0;
+    {
+        Statement stmt(*this, Query::DataVersion);
+        if (stmt.step() == SQLITE_ROW)
+            version = sqlite3_column_int64(stmt, 0);
+    }
+    const long long changes = sqlite3_total_changes64(m_db);
+
+    if (m_cacheLoaded && version == m_cacheVersion && changes == m_cacheChanges)
+        return;
+
+    m_cache = loadRecords();
+    std::sort(m_cache.begin(), m_cache.end(), recordLess);
+    m_cacheLoaded  = true;
+    m_cacheVersion = version;
+    m_cacheChanges = changes;
+}
+
+const std::vector<CableRecord>& DatabaseManager::records() const
+{
+    refreshCache();
+    return m_cache;
+}
+
+const CableRecord* DatabaseManager::findRecord(int sizeMm2) const
+{
+    refreshCache();
+    auto it = std::lower_bound(m_cache.begin(), m_cache.end(), sizeMm2,
+        [](const CableRecord& r, int size) { return r.sizeMm2 < size; });
+    return (it != m_cache.end() && it->sizeMm2 == sizeMm2) ? &*it : nullptr;
+}
@@ -1,22 +1,63 @@
 #pragma once
 
 #include "CableData.h"
+#include "Study.h"
+#include <array>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 // Forward-declare sqlite3 so headers that include us don't need sqlite3.h
 struct sqlite3;
+struct sqlite3_stmt;
+
+// ── Catalogue filter — every set field must match ────────────────────────────
+struct CableFilter {
+    std::optional<int>               manufacturerId;
+    std::optional<double>            voltageKV;
+    std::optional<ConductorMaterial> material;
+    std::optional<Insulation>        insulation;
+    std::optional<int>               minSizeMm2;
+    std::optional<int>               maxSizeMm2;
+    std::optional<double>            maxDcResistance;   // Ohm/km at 20 °C
+
+    // Same test as the SQL in DatabaseManager::forEach(), for records
+    // already in memory
+    bool matches(const CableRecord& r) const
+    {
+        return (!manufacturerId  || r.manufacturerId    == *manufacturerId)
+            && (!voltageKV       || r.voltageKV         == *voltageKV)
+            && (!material        || r.material          == *material)
+            && (!insulation      || r.insulation        == *insulation)
+            && (!minSizeMm2      || r.sizeMm2           >= *minSizeMm2)
+            && (!maxSizeMm2      || r.sizeMm2           <= *maxSizeMm2)
+            && (!maxDcResistance || r.maxDcResistance20C <= *maxDcResistance);
+    }
+};
 
 // ─────────────────────────────────────────────────────────────────────────────
 // DatabaseManager
 //   Thin RAII wrapper around a SQLite connection.
 //   On first open it creates the schema and seeds all cable records.
 //   All public methods are safe to call after a successful open().
+//
+//   Threading: SQLite is built multi-thread (SQLITE_THREADSAFE=2) with a WAL
+//   journal, so no connection is ever shared between threads.  The main
+//   connection belongs to the thread that opened the database and serves
+//   writes and the record cache.  The SQL reads — fetchBySize(),
+//   availableSizes(), forEach(), query() and manufacturers() — borrow a
+//   read-only connection from a small pool instead, so worker threads may
+//   call them concurrently.  Do not close() while a worker is mid-query.
 // ─────────────────────────────────────────────────────────────────────────────
 class DatabaseManager
 {
 public:
-    DatabaseManager() = default;
+    DatabaseManager();
     ~DatabaseManager();
 
     // Non-copyable
@@ -31,16 +72,138 @@ public:
     bool        isOpen()        const { return m_db != nullptr; }
     std::string errorMessage()  const { return m_error; }
 
+    // Most read connections open at once (default 4); they are opened on
+    // first use and callers wait while all are busy.
+    void setReadPoolSize(size_t size);
+
     // ── Queries ───────────────────────────────────────────────────────────────
     std::vector<CableRecord> allRecords()       const;
     CableRecord              recordBySize(int sizeMm2) const; // zeroed if not found
     std::vector<int>         availableSizes()   const;
 
+    // Counter bumped by every change to catalogue records, from any
+    // connection; saving studies does not move it.  -1 if not open.
+    long long                catalogueVersion() const;
+
+    // The same counter read from the file at `path` without opening a
+    // manager: one read-only connection, one SELECT, no schema setup or
+    // writes.  -1 if the file is missing, not a database or predates the
+    // counter.
+    static long long storedCatalogueVersion(const std::string& path);
+
+    // Single-row lookup through SQL (indexed), bypassing the record cache.
+    // Returns false and leaves `out` untouched if the size is not found.
+    bool                     fetchBySize(int sizeMm2, CableRecord& out) const;
+
+    // ── Filtered catalogue queries ────────────────────────────────────────────
+    // Stream matching records in size order straight from SQLite without
+    // loading the catalogue.  Stops after `limit` records (0 = no limit) and
+    // returns the number visited.  `visit` must not call forEach() again.
+    using RecordVisitor = std::function<void(const CableRecord&)>;
+    size_t forEach(const CableFilter& filter, const RecordVisitor& visit,
+                   size_t limit = 0) const;
+    std::vector<CableRecord> query(const CableFilter& filter, size_t limit = 0) const;
+
+    // ── Manufacturers ─────────────────────────────────────────────────────────
+    // Id for `name`, adding it if new; 0 on failure.
+    int manufacturerId(const std::string& name);
+    std::vector<std::pair<int, std::string>> manufacturers() const;   // by id
+
+    // ── Bulk import ───────────────────────────────────────────────────────────
+    // Upsert `records` in a single transaction, keyed by size, manufacturer,
+    // voltage class, material and insulation; an existing entry has its
+    // electrical data replaced.  manufacturerId must be a database id (see
+    // manufacturerId()).  progress(done, total) is called every few thousand
+    // rows and once at the end.  On failure nothing is written.
+    using ImportProgress = std::function<void(size_t done, size_t total)>;
+    bool importRecords(const std::vector<CableRecord>& records,
+                       const ImportProgress& progress = {});
+
+    // ── Studies ───────────────────────────────────────────────────────────────
+    // Save `study` under its name in one transaction, replacing any earlier
+    // save of that name.  Route results are stored only if sectionKeys match
+    // the route (i.e. they are its current solution); scenario results only
+    // if systemSolved.
+    bool saveStudy(const Study& study);
+
+    // Load the study called `name`; false if there is none, or with
+    // errorMessage() set if its stored arrangement or formula code is out of
+    // range (a damaged row, or one from a newer build).  sectionKeys always
+    // describe the loaded route.
+    bool loadStudy(const std::string& name, Study& out) const;
+
+    std::vector<std::string> studyNames() const;   // Most recently saved first
+
+    // ── Record cache ──────────────────────────────────────────────────────────
+    // Every record, sorted by size then manufacturer, voltage, material and
+    // insulation, loaded once and reloaded only when the database changes
+    // (this or any other connection).  The reference and pointers stay valid
+    // until the next reload or close().  Size lookups return the first entry
+    // for that size in this order.
+    const std::vector<CableRecord>& records() const;
+    const CableRecord*              findRecord(int sizeMm2) const; // nullptr if not found
+
+    // ── Prepared-statement pool ───────────────────────────────────────────────
+    // Every statement is prepared once in open() and reset/rebound per use.
+    enum class Query {
+        DataVersion, CatalogueVersion, CountSizes, InsertSize, InsertElectrical,
+        AllRecords, RecordBySize, AvailableSizes,
+        Synchronous, CacheSize, UpsertSize,
+        UpsertManufacturer, AllManufacturers,
+        DeleteStudy, InsertStudy, InsertScenario, InsertRoute, InsertSection,
+        StudyByName, StudyScenario, StudyRoute, StudySections, StudyNames,
+        Filter,   // statistics only; statements are per filter shape
+        Count_
+    };
+
+    struct QueryStats {
+        long long calls        = 0;
+        double    totalMicros  = 0.0;   // Wall time from first step to reset,
+                                        // including the caller's work per row
+        double    maxMicros    = 0.0;
+        double    meanMicros() const { return calls ? totalMicros / calls : 0.0; }
+    };
+
+    QueryStats queryStats(Query q) const;
+    void       resetQueryStats();
+
 private:
+    class Statement;     // RAII use of a pooled statement (DatabaseManager.cpp)
+    struct Reader;       // Pooled read-only connection (DatabaseManager.cpp)
+    class ReaderLease;   // RAII borrow of a Reader
+
+    static constexpr size_t kQueryCount = static_cast<size_t>(Query::Count_);
+    static const std::array<std::string, kQueryCount>& querySql();
+
+    Reader* acquireReader() const;    // nullptr if closed or it fails to open
+    void    releaseReader(Reader* r) const;
+
+    bool prepareStatements();
     bool createSchema();
+    bool migrateSchema();
     bool seedIfEmpty();
     bool exec(const char* sql);   // fire-and-forget helper
 
-    sqlite3*    m_db    = nullptr;
-    std::string m_error;
+    std::vector<CableRecord> loadRecords() const;
+    void                     refreshCache() const;
+
+    sqlite3*    m_db = nullptr;
+    std::string m_path;
+    mutable std::string m_error;   // Const readers such as loadStudy() report too
+
+    std::array<sqlite3_stmt*, kQueryCount>       m_stmts{};
+    mutable std::array<QueryStats, kQueryCount>  m_stats{};
+    mutable std::mutex                           m_statsMutex;
+
+    // Read pool — m_readers owns every open Reader, m_idle lists free ones
+    size_t                                       m_readPoolSize = 4;
+    mutable std::mutex                           m_poolMutex;
+    mutable std::condition_variable              m_poolFree;
+    mutable std::vector<std::unique_ptr<Reader>> m_readers;
+    mutable std::vector<Reader*>                 m_idle;
+
+    mutable std::vector<CableRecord> m_cache;
+    mutable bool                     m_cacheLoaded  = false;
+    mutable long long                m_cacheVersion = 0;   // data_version at load
+    mutable long long                m_cacheChanges = 0;   // total_changes at load
 };
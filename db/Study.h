@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Calculator.h"
+#include "SheathCalc.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Study
+//   One saved piece of work: a system scenario and a sheath route, each with
+//   the results last calculated for it and the key of the inputs those
+//   results belong to.  Persisted by DatabaseManager::saveStudy/loadStudy.
+//
+//   On reopening, results whose key still matches the inputs are used as
+//   they are; for the route, sheath::solveIncremental() recomputes only from
+//   the first section that changed.
+// ─────────────────────────────────────────────────────────────────────────────
+struct Study {
+    std::string name;
+
+    // System scenario — systemResults are for systemKey, i.e.
+    // inputHash(system, cable) at the time they were calculated.
+    SystemParams  system;
+    bool          systemSolved = false;
+    std::uint64_t systemKey    = 0;
+    CalcResults   systemResults;
+
+    // Sheath route (in sheath.route).  sectionLayouts carries one caller-
+    // defined code per section (the UI's arrangement), stored untouched.
+    // sheathResults is kept at SUMMARY detail; sectionKeys are the
+    // sheath::sectionKeys() it was solved with.
+    sheath::SheathParams       sheath;
+    std::vector<int>           sectionLayouts;
+    std::vector<std::uint64_t> sectionKeys;
+    sheath::SheathResults      sheathResults;
+};
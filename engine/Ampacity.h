@@ -0,0 +1,208 @@
+#pragma once
+#include "Calculator.h"
+#include <array>
+#include <cmath>
+#include <vector>
+
+// ── Steady-state current rating (IEC 60287-1-1 / 60287-2-1) ─────────────────
+// Single-core cables, three per circuit, buried direct and equally loaded;
+// no armour (T2 = 0, λ2 = 0).  For one cable:
+//
+//   I = √[ (Δθ − Wd (½T1 + T3 + T4)) / (R T1 + R (1 + λ1)(T3 + T4)) ]
+//
+// with R the conductor AC resistance at its maximum temperature and Δθ the
+// permitted rise over ambient.  The hottest cable is rated: the centre one
+// of a flat formation.
+//
+// CableRecord has no dimensions, so they are derived: the insulation
+// diameter ratio follows from the conductor-to-screen capacitance,
+//   C = 2π ε0 εr / ln(Di/dc)   ⇒   T1 = ρins / 2π · ln(Di/dc) = ρins ε0 εr / C,
+// the conductor diameter from its area, and the screen and oversheath from
+// thicknesses common to the whole catalogue (Installation).
+//
+// Sheath losses are the circulating-current losses of screens bonded at both
+// ends; eddy currents are neglected, as IEC 60287 allows for wire screens.
+// Single-point and cross-bonded screens carry no circulating current.
+
+enum class Bonding { BothEnds, SinglePoint };   // SinglePoint covers cross-bonded
+
+struct Installation {
+    double  ambientC        = 20.0;   // Ground temperature at cable depth (°C)
+    double  depth_m         = 0.8;    // Laying depth to the cable axes (m)
+    double  soilResistivity = 1.2;    // K·m/W
+    double  flatSpacing_mm  = 0.0;    // Axis spacing for FlatSpaced; 0 → 2 × De
+    Bonding bonding         = Bonding::BothEnds;
+    double  frequency_Hz    = 50.0;
+
+    // Construction shared by every size in the catalogue
+    double screenThickness_mm     = 1.0;   // Copper wire screen, taken as a tube
+    double oversheathThickness_mm = 3.5;
+    double oversheathResistivity  = 3.5;   // K·m/W (PE)
+};
+
+// Insulation properties, IEC 60287-1-1 tables 1 and 3 (above 3 kV)
+struct InsulationProps {
+    double maxTempC;
+    double permittivity;           // εr
+    double thermalResistivity;     // K·m/W
+};
+
+inline constexpr InsulationProps insulationProps(Insulation i)
+{
+    switch (i) {
+        case Insulation::XLPE: return { 90.0, 2.5, 3.5 };
+        case Insulation::EPR:  return { 90.0, 3.0, 5.0 };
+        case Insulation::PVC:  return { 70.0, 8.0, 6.0 };
+    }
+    return { 90.0, 2.5, 3.5 };
+}
+
+struct AmpacityResult {
+    double rating_A    = 0.0;   // Continuous rating; 0 if the cable has no headroom
+    double T1          = 0.0;   // Insulation thermal resistance (K·m/W)
+    double T3          = 0.0;   // Oversheath
+    double T4          = 0.0;   // Surrounding soil
+    double lambda1     = 0.0;   // Screen loss factor
+    double screenTempC = 0.0;
+};
+
+// One rating per Arrangement, indexed by static_cast<int>(Arrangement)
+using AmpacityRow = std::array<AmpacityResult, kArrangementCount>;
+
+namespace ampacity_detail {
+
+constexpr double kPi            = 3.14159265358979323846;
+constexpr double kEpsilon0      = 8.854e-12;   // F/m
+constexpr double kConductorFill = 0.9;         // Compacted stranded conductor
+constexpr double kScreenAlpha   = 3.93e-3;     // Copper screen, 1/K
+
+} // namespace ampacity_detail
+
+// Everything that depends on the installation only — computed once and
+// shared by every size in a catalogue rating.
+struct InstallationTerms {
+    double ambientC;
+    double twoL_mm;          // 2 × depth
+    double soilOver2Pi;      // ρsoil / 2π
+    double trefoilK;         // 1.5 ρsoil / π
+    double flatK1, flatK2;   // 0.475 ρsoil, 0.346 ρsoil
+    double flatSpacing_mm;
+    double xPerLn;           // Screen reactance per ln(2s/d): 2ω·10⁻⁷ (Ω/m)
+    double screen_mm;
+    double oversheath_mm;
+    double oversheathOver2Pi;
+    bool   bothEnds;
+
+    explicit InstallationTerms(const Installation& in)
+        : ambientC(in.ambientC)
+        , twoL_mm(2000.0 * in.depth_m)
+        , soilOver2Pi(in.soilResistivity / (2.0 * ampacity_detail::kPi))
+        , trefoilK(1.5 * in.soilResistivity / ampacity_detail::kPi)
+        , flatK1(0.475 * in.soilResistivity)
+        , flatK2(0.346 * in.soilResistivity)
+        , flatSpacing_mm(in.flatSpacing_mm)
+        , xPerLn(2.0 * (2.0 * ampacity_detail::kPi * in.frequency_Hz) * 1e-7)
+        , screen_mm(in.screenThickness_mm)
+        , oversheath_mm(in.oversheathThickness_mm)
+        , oversheathOver2Pi(in.oversheathResistivity / (2.0 * ampacity_detail::kPi))
+        , bothEnds(in.bonding == Bonding::BothEnds)
+    {}
+};
+
+// Rate one cable in every arrangement.  `model` is conductorModel(cable).
+inline AmpacityRow rateCable(const CableRecord& cable, const ConductorModel& model,
+                             const InstallationTerms& in)
+{
+    using namespace ampacity_detail;
+
+    AmpacityRow row{};
+    if (cable.sizeMm2 <= 0 || cable.conductorToScreenCapacitance <= 0.0) return row;
+
+    const InsulationProps ins = insulationProps(cable.insulation);
+    const double dTheta = ins.maxTempC - in.ambientC;
+    const double Wd     = cable.dielectricLossPerPhase / 1000.0;             // W/m
+    const double C      = cable.conductorToScreenCapacitance * 1e-9;         // µF/km → F/m
+
+    // Dimensions (mm)
+    const double dc  = std::sqrt(4.0 * cable.sizeMm2 / (kPi * kConductorFill));
+    const double lnD = 2.0 * kPi * kEpsilon0 * ins.permittivity / C;         // ln(Di/dc)
+    const double Di  = dc * std::exp(lnD);
+    const double ds  = Di + in.screen_mm;                                      // Mean screen
+    const double Ds  = Di + 2.0 * in.screen_mm;
+    const double De  = Ds + 2.0 * in.oversheath_mm;
+
+    // Size-dependent thermal resistances (K·m/W)
+    const double T1 = ins.thermalResistivity / (2.0 * kPi) * lnD;
+    const double T3 = in.oversheathOver2Pi * std::log(1.0 + 2.0 * in.oversheath_mm / Ds);
+    const double u  = in.twoL_mm / De;
+
+    for (Arrangement a : { Arrangement::TrefoilTouching, Arrangement::FlatTouching,
+                           Arrangement::FlatSpaced }) {
+        AmpacityResult& r = row[arrangementIndex(a)];
+
+        double s = De;   // Axis spacing (mm)
+        switch (a) {
+            case Arrangement::TrefoilTouching:
+                r.T4 = in.trefoilK * (std::log(2.0 * u) - 0.630);
+                break;
+            case Arrangement::FlatTouching:
+                r.T4 = in.flatK1 * std::log(2.0 * u) - in.flatK2;
+                break;
+            case Arrangement::FlatSpaced: {
+                s = (in.flatSpacing_mm > 0.0) ? std::max(in.flatSpacing_mm, De) : 2.0 * De;
+                const double img = in.twoL_mm / s;
+                r.T4 = in.soilOver2Pi *
+                       std::log((u + std::sqrt(u * u - 1.0)) * (1.0 + img * img));
+                break;
+            }
+        }
+        r.T1 = T1;
+        r.T3 = T3;
+
+        const double R   = model.rac(a, ins.maxTempC) / 1000.0;                // Ω/m
+        const double num = dTheta - Wd * (0.5 * T1 + T3 + r.T4);
+        if (!(num > 0.0) || !(R > 0.0)) continue;
+
+        // λ1 depends on the screen temperature, which depends on I; a few
+        // fixed-point passes settle it to well under 0.01 A.
+        const double X = in.xPerLn * std::log(2.0 * s / ds);
+        double thetaS  = ins.maxTempC;
+        double I       = 0.0;
+        for (int pass = 0; pass < 10; ++pass) {
+            double lambda1 = 0.0;
+            if (in.bothEnds && cable.screenDcResistance20C > 0.0) {
+                const double Rs = cable.screenDcResistance20C / 1000.0
+                                * (1.0 + kScreenAlpha * (thetaS - 20.0));
+                const double q  = Rs / X;
+                lambda1 = (Rs / R) / (1.0 + q * q);
+            }
+            const double next = std::sqrt(num / (R * T1 + R * (1.0 + lambda1) * (T3 + r.T4)));
+            r.lambda1 = lambda1;
+            thetaS    = ins.maxTempC - (next * next * R + 0.5 * Wd) * T1;
+            const bool settled = std::abs(next - I) < 1e-3;
+            I = next;
+            if (settled) break;
+        }
+        r.rating_A    = I;
+        r.screenTempC = thetaS;
+    }
+    return row;
+}
+
+inline AmpacityRow rateCable(const CableRecord& cable, const Installation& in)
+{
+    return rateCable(cable, conductorModel(cable), InstallationTerms(in));
+}
+
+// Rate every record in every arrangement; the result is index-aligned with
+// `records`.  Installation terms are evaluated once for the whole catalogue.
+inline std::vector<AmpacityRow> rateCatalogue(const std::vector<CableRecord>& records,
+                                              const Installation& in)
+{
+    const InstallationTerms terms(in);
+    std::vector<AmpacityRow> out;
+    out.reserve(records.size());
+    for (const auto& r : records)
+        out.push_back(rateCable(r, conductorModel(r), terms));
+    return out;
+}
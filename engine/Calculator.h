@@ -1,9 +1,26 @@
 #pragma once
 #include "CableData.h"
+#include "InputHash.h"
+#include <algorithm>
+#include <cassert>
 #include <cmath>
+#include <functional>
 #include <string>
+#include <thread>
+#include <vector>
 
 enum class Arrangement { TrefoilTouching, FlatTouching, FlatSpaced };
+constexpr int kArrangementCount = 3;
+
+// Index of `a` into the per-arrangement tables.  Codes from outside the
+// program are range-checked before they become an Arrangement (see
+// DatabaseManager::loadStudy), so an out-of-range one here is a bug.
+inline int arrangementIndex(Arrangement a)
+{
+    const int i = static_cast<int>(a);
+    assert(i >= 0 && i < kArrangementCount);
+    return i;
+}
 
 struct SystemParams {
     double      voltageKV   = 33.0;
@@ -29,13 +46,11 @@ struct CalcResults {
     double chargingA   = 0.0;
 };
 
-// cable is looked up by the caller via DatabaseManager and passed in.
-inline CalcResults calculate(const SystemParams& p, const CableRecord& cable)
+// Per-km R and X for the chosen arrangement.
+inline void impedancePerKm(const CableRecord& cable, Arrangement arrangement,
+                           double& R_per_km, double& X_per_km)
 {
-    if (cable.sizeMm2 == 0) return {};
-
-    double R_per_km = 0.0, X_per_km = 0.0;
-    switch (p.arrangement) {
+    switch (arrangement) {
         case Arrangement::TrefoilTouching:
             R_per_km = cable.acResistanceTrefoilTouching;
             X_per_km = cable.inductiveReactanceTrefoilTouching;
@@ -51,6 +66,13 @@ inline CalcResults calculate(const SystemParams& p, const CableRecord& cable)
             X_per_km = cable.inductiveReactanceFlatSpaced;
             break;
     }
+}
+
+// Results for a cable whose per-km R and X are already known.
+inline CalcResults calculateWith(const SystemParams& p, const CableRecord& cable,
+                                 double R_per_km, double X_per_km)
+{
+    if (cable.sizeMm2 == 0) return {};
 
     CalcResults r;
     r.R = R_per_km * p.lengthKm;
@@ -74,3 +96,346 @@ inline CalcResults calculate(const SystemParams& p, const CableRecord& cable)
 
     return r;
 }
+
+// cable is looked up by the caller via DatabaseManager and passed in.
+// Resistance is the catalogue value, i.e. at the 90 °C rated temperature.
+inline CalcResults calculate(const SystemParams& p, const CableRecord& cable)
+{
+    double R_per_km = 0.0, X_per_km = 0.0;
+    impedancePerKm(cable, p.arrangement, R_per_km, X_per_km);
+    return calculateWith(p, cable, R_per_km, X_per_km);
+}
+
+// Key for stored results: every value calculate() reads from p and cable.
+inline std::uint64_t inputHash(const SystemParams& p, const CableRecord& cable)
+{
+    InputHash h;
+    h.add(p.voltageKV).add(p.powerMVA).add(p.powerFactor).add(p.lengthKm)
+     .add(static_cast<int>(p.arrangement)).add(p.sizeMm2);
+    h.add(cable.sizeMm2)
+     .add(cable.acResistanceTrefoilTouching).add(cable.inductiveReactanceTrefoilTouching)
+     .add(cable.acResistanceFlatTouching).add(cable.inductiveReactanceFlatTouching)
+     .add(cable.acResistanceFlatSpaced).add(cable.inductiveReactanceFlatSpaced)
+     .add(cable.dielectricLossPerPhase).add(cable.chargingCurrentPerPhase);
+    return h.value();
+}
+
+// ── Conductor temperature ─────────────────────────────────────────────────────
+// The catalogue gives DC resistance at 20 °C and AC resistance at 90 °C.
+// Between them:
+//
+//   Rdc(θ) = Rdc20 · (1 + α (θ − 20))
+//   Rac(θ) = Rdc(θ) · (1 + y(θ)),   y(θ) = y90 · (Rdc90 / Rdc(θ))²
+//
+// where y is the skin + proximity factor, fitted per arrangement so Rac(90)
+// is the catalogue value, and scaled as IEC 60287-1-1 does (y ∝ 1/Rdc² for
+// the small arguments of power-frequency conductors).
+//
+// The conductor temperature under load solves θ = θamb + T · (I² Rac(θ) + Wd),
+// T being the conductor-to-ambient thermal resistance.  Dielectric loss is
+// taken as generated at the conductor, which slightly overstates the rise.
+
+inline constexpr double kRatedConductorTempC = 90.0;
+
+// Temperature coefficient of resistance at 20 °C (1/K), IEC 60287-1-1
+inline constexpr double tempCoefficient(ConductorMaterial m)
+{
+    return m == ConductorMaterial::Al ? 4.03e-3 : 3.93e-3;
+}
+
+// Per-cable coefficients — everything the temperature solve needs, derived
+// once per cable rather than per scenario.
+struct ConductorModel {
+    double rdc20 = 0.0;   // DC resistance at 20 °C (Ω/km)
+    double alpha = 0.0;   // Temperature coefficient (1/K)
+    double rdc90 = 0.0;   // DC resistance at 90 °C (Ω/km)
+    double y90[kArrangementCount] = {};   // Skin + proximity factor at 90 °C
+    double x[kArrangementCount]   = {};   // Reactance (Ω/km)
+
+    // Folded constants for conductorTemperature()
+    double invAlpha      = 0.0;   // 1/α
+    double invAlphaRdc20 = 0.0;   // 1/(α Rdc20)
+    double yRdc90Sq[kArrangementCount] = {};   // y90 · Rdc90²
+
+    double rdc(double tempC) const { return rdc20 * (1.0 + alpha * (tempC - 20.0)); }
+
+    double rac(Arrangement a, double tempC) const
+    {
+        const double dc = rdc(tempC);
+        const double k  = rdc90 / dc;
+        return dc * (1.0 + y90[arrangementIndex(a)] * k * k);
+    }
+};
+
+inline ConductorModel conductorModel(const CableRecord& cable)
+{
+    ConductorModel m;
+    m.rdc20 = cable.maxDcResistance20C;
+    m.alpha = tempCoefficient(cable.material);
+    m.rdc90 = m.rdc(kRatedConductorTempC);
+    for (Arrangement a : { Arrangement::TrefoilTouching, Arrangement::FlatTouching,
+                           Arrangement::FlatSpaced }) {
+        double R = 0.0, X = 0.0;
+        impedancePerKm(cable, a, R, X);
+        const int i = arrangementIndex(a);
+        m.y90[i]      = (m.rdc90 > 0.0) ? R / m.rdc90 - 1.0 : 0.0;
+        m.x[i]        = X;
+        m.yRdc90Sq[i] = m.y90[i] * m.rdc90 * m.rdc90;
+    }
+    m.invAlpha      = 1.0 / m.alpha;
+    m.invAlphaRdc20 = (m.rdc20 > 0.0) ? m.invAlpha / m.rdc20 : 0.0;
+    return m;
+}
+
+// Index-aligned with `records`; build once per catalogue and reuse.
+inline std::vector<ConductorModel> conductorModels(const std::vector<CableRecord>& records)
+{
+    std::vector<ConductorModel> out;
+    out.reserve(records.size());
+    for (const auto& r : records) out.push_back(conductorModel(r));
+    return out;
+}
+
+struct ThermalParams {
+    double ambientC          = 20.0;  // Ambient (ground or air) temperature (°C)
+    double thermalResistance = 0.0;   // Conductor to ambient, per phase (K·m/W)
+};
+
+struct ThermalResult {
+    double conductorTempC = 0.0;
+    double acResistance   = 0.0;     // Rac at conductorTempC (Ω/km)
+    bool   steady         = false;   // false → heating outruns cooling (runaway)
+};
+
+// Steady-state conductor temperature for load current I (A).
+//
+// Written in u = Rdc(θ), which is linear in θ, the heat balance is
+//   (u − Rdc20) / (α Rdc20) + 20 − θamb − d = c (u + y90 Rdc90² / u)
+// with c = T I², d = T Wd.  Multiplying through by u leaves a quadratic, so
+// the fixed point is found directly rather than by iterating on θ:
+//   A u² + B u + C = 0,  A = 1/(α Rdc20) − c,  B = 20 − θamb − d − 1/α,
+//                        C = −c y90 Rdc90²
+// A ≤ 0 is thermal runaway: resistive heating grows faster with temperature
+// than the thermal resistance can shed it.  Otherwise the physical root is
+// the larger one (the only positive root when y90 ≥ 0).
+inline ThermalResult conductorTemperature(const ConductorModel& m, Arrangement a,
+                                          double current_A, double dielLossPerPhase,
+                                          const ThermalParams& t)
+{
+    // Ω/km → Ω/m and W/km → W/m
+    const double c = t.thermalResistance * current_A * current_A / 1000.0;
+    const double d = t.thermalResistance * dielLossPerPhase / 1000.0;
+
+    const double yr = m.yRdc90Sq[arrangementIndex(a)];
+
+    ThermalResult out;
+    if (c == 0.0 || m.rdc20 <= 0.0) {
+        out.conductorTempC = t.ambientC + d;
+        out.acResistance   = m.rac(a, out.conductorTempC);
+        out.steady         = true;
+        return out;
+    }
+
+    const double A    = m.invAlphaRdc20 - c;
+    const double B    = 20.0 - t.ambientC - d - m.invAlpha;
+    const double C    = -c * yr;
+    const double disc = B * B - 4.0 * A * C;
+    if (!(A > 0.0) || disc < 0.0) {
+        out.conductorTempC = kRatedConductorTempC;
+        out.acResistance   = m.rac(a, kRatedConductorTempC);
+        return out;
+    }
+
+    const double u = (-B + std::sqrt(disc)) / (2.0 * A);
+    out.conductorTempC = 20.0 + (u * m.invAlphaRdc20 - m.invAlpha);
+    out.acResistance   = u + yr / u;
+    out.steady         = true;
+    return out;
+}
+
+// calculate() with resistance at the steady-state conductor temperature for
+// the scenario's load current.  `model` is conductorModel(cable), passed in so
+// repeated calls share it.  If there is no steady state (`thermal->steady`
+// false) R is the catalogue 90 °C value and the results are only indicative.
+inline CalcResults calculate(const SystemParams& p, const CableRecord& cable,
+                             const ConductorModel& model, const ThermalParams& t,
+                             ThermalResult* thermal = nullptr)
+{
+    const double current = (p.powerMVA * 1e6) / (std::sqrt(3.0) * p.voltageKV * 1000.0);
+    const ThermalResult th = conductorTemperature(model, p.arrangement, current,
+                                                  cable.dielectricLossPerPhase, t);
+    if (thermal) *thermal = th;
+
+    return calculateWith(p, cable, th.acResistance, model.x[arrangementIndex(p.arrangement)]);
+}
+
+inline CalcResults calculate(const SystemParams& p, const CableRecord& cable,
+                             const ThermalParams& t, ThermalResult* thermal = nullptr)
+{
+    return calculate(p, cable, conductorModel(cable), t, thermal);
+}
+
+// ── Batch evaluation ──────────────────────────────────────────────────────────
+// Structure-of-arrays scenario table.  Cable data is resolved to per-km values
+// as scenarios are added, so the kernel streams contiguous doubles only.
+struct ScenarioTable {
+    std::vector<double>        voltageKV;
+    std::vector<double>        powerMVA;
+    std::vector<double>        powerFactor;
+    std::vector<double>        lengthKm;
+    std::vector<double>        R_per_km;
+    std::vector<double>        X_per_km;
+    std::vector<double>        dielLossPerPhase;
+    std::vector<double>        chargingPerPhase;
+    std::vector<double>        cableWeight;  // 1, or 0 → all-zero results as calculate()
+
+    size_t size() const { return voltageKV.size(); }
+
+    void reserve(size_t n)
+    {
+        for (auto* v : { &voltageKV, &powerMVA, &powerFactor, &lengthKm, &R_per_km,
+                         &X_per_km, &dielLossPerPhase, &chargingPerPhase, &cableWeight })
+            v->reserve(n);
+    }
+
+    void add(const SystemParams& p, const CableRecord& cable)
+    {
+        double R = 0.0, X = 0.0;
+        impedancePerKm(cable, p.arrangement, R, X);
+        voltageKV       .push_back(p.voltageKV);
+        powerMVA        .push_back(p.powerMVA);
+        powerFactor     .push_back(p.powerFactor);
+        lengthKm        .push_back(p.lengthKm);
+        R_per_km        .push_back(R);
+        X_per_km        .push_back(X);
+        dielLossPerPhase.push_back(cable.dielectricLossPerPhase);
+        chargingPerPhase.push_back(cable.chargingCurrentPerPhase);
+        cableWeight     .push_back(cable.sizeMm2 != 0 ? 1.0 : 0.0);
+    }
+};
+
+// Structure-of-arrays counterpart of CalcResults.
+struct CalcResultsTable {
+    std::vector<double> R, X, Z, current, deltaV_V, deltaV_pct, P_MW, Q_Mvar,
+                        losses_kW, dielLoss_kW, losses_pct, chargingA;
+
+    size_t size() const { return R.size(); }
+
+    void resize(size_t n)
+    {
+        for (auto* v : { &R, &X, &Z, &current, &deltaV_V, &deltaV_pct, &P_MW,
+                         &Q_Mvar, &losses_kW, &dielLoss_kW, &losses_pct, &chargingA })
+            v->resize(n);
+    }
+
+    CalcResults at(size_t i) const
+    {
+        CalcResults r;
+        r.R = R[i];               r.X = X[i];                 r.Z = Z[i];
+        r.current = current[i];   r.deltaV_V = deltaV_V[i];   r.deltaV_pct = deltaV_pct[i];
+        r.P_MW = P_MW[i];         r.Q_Mvar = Q_Mvar[i];       r.losses_kW = losses_kW[i];
+        r.dielLoss_kW = dielLoss_kW[i];
+        r.losses_pct  = losses_pct[i];
+        r.chargingA   = chargingA[i];
+        return r;
+    }
+};
+
+// Batch kernel over n scenarios.  The pointers are restrict-qualified
+// parameters (GCC ignores restrict on locals): with 21 arrays in play the
+// compiler will not vectorise behind runtime alias checks.
+inline void calculateBatchKernel(size_t n,
+    const double* __restrict V,   const double* __restrict S,
+    const double* __restrict pf,  const double* __restrict L,
+    const double* __restrict Rkm, const double* __restrict Xkm,
+    const double* __restrict Wd,  const double* __restrict Ich,
+    const double* __restrict W,
+    double* __restrict oR,    double* __restrict oX,    double* __restrict oZ,
+    double* __restrict oI,    double* __restrict odV,   double* __restrict odVp,
+    double* __restrict oP,    double* __restrict oQ,    double* __restrict oLoss,
+    double* __restrict oDiel, double* __restrict oLp,   double* __restrict oCh)
+{
+    const double sqrt3 = std::sqrt(3.0);
+
+    for (size_t i = 0; i < n; ++i) {
+        // Everything is computed unconditionally and weighted by 1 or 0; a
+        // select here is turned back into a branch and blocks vectorisation.
+        const double R      = Rkm[i] * L[i];
+        const double X      = Xkm[i] * L[i];
+        const double Z      = std::sqrt(R * R + X * X);
+        const double Vph    = (V[i] * 1000.0) / sqrt3;
+        const double I      = (S[i] * 1e6) / (sqrt3 * V[i] * 1000.0);
+        const double sinPhi = std::sqrt(std::max(0.0, 1.0 - pf[i] * pf[i]));
+        const double dVph   = I * (R * pf[i] + X * sinPhi);
+        const double dVpct  = (dVph / Vph) * 100.0;
+        const double P      = S[i] * pf[i];
+        const double loss   = 3.0 * I * I * R / 1000.0;
+        const double lossPc = (loss / (P * 1e3)) * 100;
+        const double diel   = Wd[i] * L[i] * 3.0 / 1000.0;
+        const double w      = W[i];
+
+        oR[i]    = w * R;
+        oX[i]    = w * X;
+        oZ[i]    = w * Z;
+        oI[i]    = w * I;
+        odV[i]   = w * dVph * sqrt3;
+        odVp[i]  = w * dVpct;
+        oP[i]    = w * P;
+        oQ[i]    = w * S[i] * sinPhi;
+        oLoss[i] = w * loss;
+        oDiel[i] = w * diel;
+        oLp[i]   = w * lossPc;
+        oCh[i]   = w * Ich[i] * L[i];
+    }
+}
+
+// Same arithmetic as calculate() over scenarios [begin, end).  Results match
+// calculate() bit for bit for finite inputs (V > 0, S·pf > 0) as long as
+// neither is compiled with FP contraction, which the build turns off for
+// every file (see CMakeLists.txt).
+inline void calculateBatchRange(const ScenarioTable& in, CalcResultsTable& out,
+                                size_t begin, size_t end)
+{
+    if (begin >= end) return;
+    calculateBatchKernel(end - begin,
+        in.voltageKV.data() + begin,        in.powerMVA.data() + begin,
+        in.powerFactor.data() + begin,      in.lengthKm.data() + begin,
+        in.R_per_km.data() + begin,         in.X_per_km.data() + begin,
+        in.dielLossPerPhase.data() + begin, in.chargingPerPhase.data() + begin,
+        in.cableWeight.data() + begin,
+        out.R.data() + begin,           out.X.data() + begin,
+        out.Z.data() + begin,           out.current.data() + begin,
+        out.deltaV_V.data() + begin,    out.deltaV_pct.data() + begin,
+        out.P_MW.data() + begin,        out.Q_Mvar.data() + begin,
+        out.losses_kW.data() + begin,   out.dielLoss_kW.data() + begin,
+        out.losses_pct.data() + begin,  out.chargingA.data() + begin);
+}
+
+// Evaluate every scenario in `in`.  Large batches are split across
+// `threads` workers (0 = one per hardware thread).
+inline void calculateBatch(const ScenarioTable& in, CalcResultsTable& out,
+                           unsigned threads = 0)
+{
+    const size_t n = in.size();
+    out.resize(n);
+
+    constexpr size_t kMinPerThread = 16384;   // below this threading costs more than it saves
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(1, n / kMinPerThread)));
+
+    if (threads <= 1) {
+        calculateBatchRange(in, out, 0, n);
+        return;
+    }
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    const size_t chunk = (n + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; ++t) {
+        const size_t b = t * chunk;
+        const size_t e = std::min(n, b + chunk);
+        if (b >= e) break;
+        pool.emplace_back(calculateBatchRange, std::cref(in), std::ref(out), b, e);
+    }
+    for (auto& th : pool) th.join();
+}
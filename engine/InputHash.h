@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+// ── Input hashing ─────────────────────────────────────────────────────────────
+// 64-bit FNV-1a over the exact bit patterns of calculation inputs, used to
+// key stored results.  Equal inputs always give equal keys; any change to an
+// input (however small) gives a different key with overwhelming likelihood.
+// Not for security.
+class InputHash {
+public:
+    InputHash() = default;
+    explicit InputHash(std::uint64_t seed) : m_h(seed) {}
+
+    InputHash& add(double v)
+    {
+        std::uint64_t u;
+        std::memcpy(&u, &v, sizeof u);
+        return addBits(u);
+    }
+    InputHash& add(int v)  { return addBits(static_cast<std::uint64_t>(static_cast<std::int64_t>(v))); }
+    InputHash& add(bool v) { return addBits(v ? 1u : 0u); }
+
+    std::uint64_t value() const { return m_h; }
+
+private:
+    InputHash& addBits(std::uint64_t u)
+    {
+        for (int i = 0; i < 8; ++i) {
+            m_h ^= (u >> (8 * i)) & 0xffu;
+            m_h *= 0x100000001b3ull;
+        }
+        return *this;
+    }
+
+    std::uint64_t m_h = 0xcbf29ce484222325ull;
+};
@@ -0,0 +1,114 @@
+#pragma once
+#include "Calculator.h"
+#include <algorithm>
+#include <vector>
+
+// ── Size / arrangement optimiser ──────────────────────────────────────────────
+// Evaluates every cable record in every arrangement against voltage-drop and
+// loss limits and returns the feasible set, smallest conductor first.
+//
+// For a fixed system, dV% grows with R and X and loss% grows with R.  When R
+// and X per km never increase with conductor size (true of the built-in data)
+// feasibility is monotonic in size, so the smallest feasible size is found by
+// binary search and the sizes below it are never evaluated.  Records that
+// break the ordering fall back to a full scan of that arrangement.
+
+struct OptimiserConstraints {
+    double maxDeltaV_pct = 3.0;   // Voltage drop limit (% of nominal)
+    double maxLosses_pct = 2.0;   // Resistive loss limit (% of active power)
+};
+
+struct OptimiserCandidate {
+    int         sizeMm2     = 0;
+    Arrangement arrangement = Arrangement::TrefoilTouching;
+    CalcResults results;
+};
+
+struct OptimiserResult {
+    std::vector<OptimiserCandidate> feasible;   // Ranked, best first
+    int evaluated = 0;                           // Distinct calculate() calls made
+    int searched  = 0;                           // size × arrangement pairs
+};
+
+inline bool meetsConstraints(const CalcResults& r, const OptimiserConstraints& c)
+{
+    return r.deltaV_pct <= c.maxDeltaV_pct && r.losses_pct <= c.maxLosses_pct;
+}
+
+// base supplies voltage, power, power factor and length; its size and
+// arrangement are ignored.
+inline OptimiserResult optimise(const SystemParams& base,
+                                const std::vector<CableRecord>& records,
+                                const OptimiserConstraints& limits)
+{
+    OptimiserResult out;
+
+    std::vector<const CableRecord*> bySize;
+    bySize.reserve(records.size());
+    for (const auto& r : records)
+        if (r.sizeMm2 > 0) bySize.push_back(&r);
+    std::sort(bySize.begin(), bySize.end(),
+              [](const CableRecord* a, const CableRecord* b) { return a->sizeMm2 < b->sizeMm2; });
+
+    const int n = static_cast<int>(bySize.size());
+
+    // Results of the sizes already evaluated in the current arrangement, so
+    // binary-search probes are not calculated again by the scan
+    std::vector<CalcResults> cached(n);
+    std::vector<char>        isCached(n);
+
+    for (Arrangement arr : { Arrangement::TrefoilTouching,
+                             Arrangement::FlatTouching,
+                             Arrangement::FlatSpaced }) {
+        SystemParams p = base;
+        p.arrangement  = arr;
+        out.searched  += n;
+
+        std::fill(isCached.begin(), isCached.end(), 0);
+        auto evaluate = [&](int i) -> const CalcResults& {
+            if (!isCached[i]) {
+                p.sizeMm2   = bySize[i]->sizeMm2;
+                cached[i]   = calculate(p, *bySize[i]);
+                isCached[i] = 1;
+                ++out.evaluated;
+            }
+            return cached[i];
+        };
+
+        bool monotonic = true;
+        double prevR = 0.0, prevX = 0.0;
+        for (int i = 0; i < n && monotonic; ++i) {
+            double R = 0.0, X = 0.0;
+            impedancePerKm(*bySize[i], arr, R, X);
+            if (i > 0 && (R > prevR || X > prevX)) monotonic = false;
+            prevR = R;
+            prevX = X;
+        }
+
+        // First index that could be feasible
+        int first = 0;
+        if (monotonic) {
+            int lo = 0, hi = n;
+            while (lo < hi) {
+                const int mid = lo + (hi - lo) / 2;
+                if (meetsConstraints(evaluate(mid), limits)) hi = mid;
+                else                                         lo = mid + 1;
+            }
+            first = lo;
+        }
+
+        for (int i = first; i < n; ++i) {
+            const CalcResults& r = evaluate(i);
+            if (!meetsConstraints(r, limits)) continue;
+            out.feasible.push_back({ bySize[i]->sizeMm2, arr, r });
+        }
+    }
+
+    // Smallest conductor first, then lowest voltage drop
+    std::stable_sort(out.feasible.begin(), out.feasible.end(),
+        [](const OptimiserCandidate& a, const OptimiserCandidate& b) {
+            if (a.sizeMm2 != b.sizeMm2) return a.sizeMm2 < b.sizeMm2;
+            return a.results.deltaV_pct < b.results.deltaV_pct;
+        });
+    return out;
+}
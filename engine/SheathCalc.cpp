@@ -3,8 +3,21 @@
 // Pure calculation engine — no UI, no arrangement logic, no cable OD.
 // ─────────────────────────────────────────────────────────────────────────────
 #include "SheathCalc.hpp"
+#include "InputHash.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#  define SHEATH_X86 1
+#  include <immintrin.h>
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+#  endif
+#endif
 
 namespace sheath {
 
@@ -12,11 +25,11 @@ using cd = std::complex<double>;
 static constexpr double PI = 3.14159265358979323846;
 
 // ─────────────────────────────────────────────────────────────────────────────
-// calcEpm — induced sheath EMF per metre (complex, V/m)
+// calcEpmCoeff — induced sheath EMF per metre per ampere of phase current
+// (complex, V/m/A), so that  Epm[p] = I[p] · K[p].
 // All spacing arguments in metres.
 // ─────────────────────────────────────────────────────────────────────────────
-static std::array<cd, 3> calcEpm(
-    cd Ia, cd Ib, cd Ic,
+static std::array<cd, 3> calcEpmCoeff(
     double Sab, double Sbc, double Sac,
     double f,
     SheathParams::Formula formula)
@@ -26,61 +39,275 @@ static std::array<cd, 3> calcEpm(
     const cd     jw    = cd(0.0, w);
     const double sq3_2 = std::sqrt(3.0) / 2.0;
 
-    std::array<cd, 3> Epm{};
+    std::array<cd, 3> K{};
 
     if (formula == SheathParams::Formula::SIMPLIFIED) {
-        Epm[0] = jw * Ia * mu * (-0.5 * std::log((2.0*Sab*Sab) / (Sab*Sac)));
-        Epm[1] = jw * Ib * mu * (-0.5 * std::log((4.0*Sbc*Sbc) / (Sab*Sab)));
-        Epm[2] = jw * Ic * mu * (-0.5 * std::log((2.0*Sbc*Sbc) / (Sab*Sac)));
+        K[0] = jw * mu * (-0.5 * std::log((2.0*Sab*Sab) / (Sab*Sac)));
+        K[1] = jw * mu * (-0.5 * std::log((4.0*Sbc*Sbc) / (Sab*Sab)));
+        K[2] = jw * mu * (-0.5 * std::log((2.0*Sbc*Sbc) / (Sab*Sac)));
     } else {
-        Epm[0] = jw * Ia * mu * (
+        K[0] = jw * mu * (
             (-0.5 * std::log((2.0*Sab*Sab) / (Sab*Sac)))
             + cd(0.0, sq3_2) * std::log((2.0*Sac) / Sab));
 
-        Epm[1] = jw * Ib * mu * (
+        K[1] = jw * mu * (
             (0.5 * std::log((4.0*Sab*Sbc) / (Sab*Sab)))
             + cd(0.0, sq3_2) * std::log(Sbc / Sab));
 
-        Epm[2] = jw * Ic * mu * (
+        K[2] = jw * mu * (
             (-0.5 * std::log((2.0*Sbc*Sbc) / (Sab*Sac)))
             - cd(0.0, sq3_2) * std::log((2.0*Sac) / Sab));
     }
-    return Epm;
+    return K;
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-// calculate
+// EpmCache — memoised calcEpmCoeff keyed by geometry, frequency and formula.
+// Real routes repeat the same trench geometry many times and current sweeps
+// re-solve the same route; both then skip the logs entirely.
+// Direct-mapped (a colliding key simply replaces the slot) so a lookup is one
+// multiply-hash and one compare, and memory stays fixed.  Thread-local, so
+// concurrent solves need no locking.
 // ─────────────────────────────────────────────────────────────────────────────
-SheathResults calculate(const SheathParams& params)
+namespace {
+
+class EpmCache {
+public:
+    const std::array<cd, 3>& get(double Sab, double Sbc, double Sac,
+                                 double f, SheathParams::Formula formula)
+    {
+        const int fm = static_cast<int>(formula);
+        Slot& slot = m_slots[index(Sab, Sbc, Sac, f, fm)];
+        if (!(slot.used && slot.Sab == Sab && slot.Sbc == Sbc && slot.Sac == Sac
+              && slot.f == f && slot.formula == fm)) {
+            slot = { true, Sab, Sbc, Sac, f, fm,
+                     calcEpmCoeff(Sab, Sbc, Sac, f, formula) };
+        }
+        return slot.K;
+    }
+
+private:
+    struct Slot {
+        bool   used = false;
+        double Sab = 0.0, Sbc = 0.0, Sac = 0.0, f = 0.0;
+        int    formula = 0;
+        std::array<cd, 3> K{};
+    };
+
+    static constexpr size_t kSlots = 1024;   // power of two
+
+    static uint64_t bits(double v) {
+        uint64_t u;
+        std::memcpy(&u, &v, sizeof u);
+        return u;
+    }
+    static size_t index(double Sab, double Sbc, double Sac, double f, int fm) {
+        uint64_t h = bits(Sab) * 0x9e3779b97f4a7c15ull;
+        h = (h ^ bits(Sbc)) * 0xc2b2ae3d27d4eb4full;
+        h = (h ^ bits(Sac)) * 0x165667b19e3779f9ull;
+        h = (h ^ bits(f) ^ static_cast<uint64_t>(fm)) * 0x9e3779b97f4a7c15ull;
+        return static_cast<size_t>(h >> 32) & (kSlots - 1);
+    }
+
+    std::array<Slot, kSlots> m_slots{};
+};
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// calcEpm — induced sheath EMF per metre (complex, V/m)
+// All spacing arguments in metres.
+// ─────────────────────────────────────────────────────────────────────────────
+static std::array<cd, 3> calcEpm(
+    cd Ia, cd Ib, cd Ic,
+    double Sab, double Sbc, double Sac,
+    double f,
+    SheathParams::Formula formula)
+{
+    thread_local EpmCache cache;
+    const auto& K = cache.get(Sab, Sbc, Sac, f, formula);
+    return { Ia * K[0], Ib * K[1], Ic * K[2] };
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// rotatePhases — cross-bond sheath transpose  A←C, C←B, B←A
+// ─────────────────────────────────────────────────────────────────────────────
+template <typename T>
+static void rotatePhases(std::array<T, 3>& e)
+{
+    T tmp = e[0];
+    e[0]  = e[2];
+    e[2]  = e[1];
+    e[1]  = tmp;
+}
+
+// Phasor at distance t (m) into a section: E0 + t·dE.  Shared by the peak
+// search and the profile expansion so both see bit-identical values.
+static std::array<cd, 3> sampleAt(const std::array<cd, 3>& E0,
+                                  const std::array<cd, 3>& dE, double t)
+{
+    return { E0[0] + t * dE[0], E0[1] + t * dE[1], E0[2] + t * dE[2] };
+}
+
+// Offset of sample j (1 … n) into a section.  The last sample lands on the
+// section end exactly rather than on n·(L/n).
+static double sampleOffset(const SectionSolution& sec, int j)
+{
+    return (j == sec.samples) ? sec.length_m
+                              : sec.length_m * j / sec.samples;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Magnitude kernels — mag[i] = sqrt(re[i]² + im[i]²)
+// Plain sqrt rather than std::abs/hypot: sheath voltages are nowhere near the
+// overflow range, and every variant below then rounds identically, so peaks
+// and profile magnitudes agree bit for bit.  That needs a*a + b*b kept as two
+// roundings: the intrinsics are explicit, and CMakeLists.txt builds with
+// -ffp-contract=off so the compiler does not fuse the scalar forms.
+// ─────────────────────────────────────────────────────────────────────────────
+double magnitude(cd v)
+{
+    return std::sqrt(v.real() * v.real() + v.imag() * v.imag());
+}
+
+using MagnitudeKernel = void (*)(const double*, const double*, double*, size_t);
+
+static void magnitudesScalar(const double* re, const double* im,
+                             double* mag, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        mag[i] = std::sqrt(re[i] * re[i] + im[i] * im[i]);
+}
+
+#ifdef SHEATH_X86
+static void magnitudesSse2(const double* re, const double* im,
+                           double* mag, size_t n)
+{
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d r = _mm_loadu_pd(re + i);
+        __m128d m = _mm_loadu_pd(im + i);
+        __m128d s = _mm_add_pd(_mm_mul_pd(r, r), _mm_mul_pd(m, m));
+        _mm_storeu_pd(mag + i, _mm_sqrt_pd(s));
+    }
+    magnitudesScalar(re + i, im + i, mag + i, n - i);
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("avx2")))
+#endif
+static void magnitudesAvx2(const double* re, const double* im,
+                           double* mag, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d r = _mm256_loadu_pd(re + i);
+        __m256d m = _mm256_loadu_pd(im + i);
+        __m256d s = _mm256_add_pd(_mm256_mul_pd(r, r), _mm256_mul_pd(m, m));
+        _mm256_storeu_pd(mag + i, _mm256_sqrt_pd(s));
+    }
+    for (; i < n; ++i)
+        mag[i] = std::sqrt(re[i] * re[i] + im[i] * im[i]);
+}
+
+static bool cpuHasAvx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int r[4];
+    __cpuid(r, 0);
+    if (r[0] < 7) return false;
+    __cpuid(r, 1);
+    const bool osxsave = (r[2] & (1 << 27)) != 0;
+    const bool avx     = (r[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx) return false;
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;   // OS saves XMM + YMM state
+    __cpuidex(r, 7, 0);
+    return (r[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif // SHEATH_X86
+
+// Picked once per process from what the CPU supports.
+static MagnitudeKernel magnitudeKernel()
+{
+    static const MagnitudeKernel k = [] {
+#ifdef SHEATH_X86
+        return cpuHasAvx2() ? &magnitudesAvx2 : &magnitudesSse2;
+#else
+        return &magnitudesScalar;
+#endif
+    }();
+    return k;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// solve
+//   validate → march (local frame) → finalise (final frame, peaks).  The
+//   incremental solve below enters the march part-way along the route.
+// ─────────────────────────────────────────────────────────────────────────────
+// Sections (or, for the profile, samples) between progress reports
+static constexpr size_t kProgressStride = 4096;
+
+// Most profile samples a route may have.  Sample indices are int, and an
+// expanded profile costs 80 bytes a sample, so this is 8 GB already.
+static constexpr double kMaxSamples = 1e8;
+
+// Step count of a section: samples taken along it, its end included.  The
+// factor guards the ceil against L/step landing a rounding error above an
+// integer (e.g. 0.3/0.1) and adding a spurious extra step.
+static double sectionSteps(double length_m, double step_m)
+{
+    return std::max(1.0, std::ceil(length_m / step_m * (1.0 - 1e-12)));
+}
+
+static bool validate(const SheathParams& params, SheathResults& res)
 {
-    SheathResults res;
     const auto& route = params.route;
 
-    // ── Validation ────────────────────────────────────────────────────────────
     if (route.empty()) {
         res.errorMsg = "Route is empty — add at least one section.";
-        return res;
+        return false;
     }
     if (params.current_A <= 0.0) {
         res.errorMsg = "Current must be > 0.";
-        return res;
+        return false;
+    }
+    if (!(params.step_m > 0.0)) {   // Also rejects NaN
+        res.errorMsg = "Sample step must be > 0.";
+        return false;
     }
+    double samples = 1.0;   // Sample 0, the route start
     for (size_t i = 0; i < route.size(); ++i) {
-        if (route[i].length_m <= 0.0) {
+        if (!(route[i].length_m > 0.0)) {
             res.errorMsg = "Section " + std::to_string(i+1) + ": length must be > 0.";
-            return res;
+            return false;
         }
         if (route[i].Sab_mm <= 0.0 || route[i].Sbc_mm <= 0.0 || route[i].Sac_mm <= 0.0) {
             res.errorMsg = "Section " + std::to_string(i+1) + ": all spacings must be > 0.";
-            return res;
+            return false;
         }
+        samples += sectionSteps(route[i].length_m, params.step_m);   // inf fails below
+    }
+    if (!(samples <= kMaxSamples)) {
+        res.errorMsg = "Route needs more than " + std::to_string(static_cast<long long>(kMaxSamples))
+                     + " samples — increase the sample step.";
+        return false;
     }
+    return true;
+}
 
-    // ── Setup ─────────────────────────────────────────────────────────────────
-    int totalLen = 0;
-    for (const auto& sec : route)
-        totalLen += static_cast<int>(sec.length_m);
-    res.totalLength = totalLen;
+// ── Section march (local frame) ───────────────────────────────────────────────
+// E0 carries the phasor at the end of the previous section.  A transpose at
+// the start of a section (other than the first) rotates it; the rotation owed
+// by everything upstream is applied in finalise().  Sections before `from`
+// must already hold their local-frame solutions.  Returns false if
+// `progress` cancelled it.
+static bool march(const SheathParams& params, SheathResults& res, size_t from,
+                  const Progress& progress)
+{
+    const auto& route = params.route;
 
     // Current phasors — IEEE 575-2014 Annex D:  a = e^(j2π/3)
     const cd a(-0.5, std::sqrt(3.0) / 2.0);
@@ -89,64 +316,407 @@ SheathResults calculate(const SheathParams& params)
     cd Ib =         I0;
     cd Ic = (a*a) * I0;
 
-    // ── Initialise from section 0 ─────────────────────────────────────────────
-    auto Epm = calcEpm(Ia, Ib, Ic,
-        route[0].Sab_mm * 1e-3,
-        route[0].Sbc_mm * 1e-3,
-        route[0].Sac_mm * 1e-3,
-        params.frequency_Hz, params.formula);
-
-    res.E   .resize(totalLen);
-    res.Emag.resize(totalLen);
-    res.E[0] = { Epm[0], Epm[1], Epm[2] };
-
-    // ── March metre by metre ──────────────────────────────────────────────────
-    int sectionVal   = 0;
-    int nextBoundary = static_cast<int>(route[0].length_m);
-
-    for (int k = 1; k < totalLen; ++k) {
-        if (k == nextBoundary) {
-            ++sectionVal;
-            if (sectionVal >= static_cast<int>(route.size())) break;
-            nextBoundary += static_cast<int>(route[sectionVal].length_m);
-
-            if (route[sectionVal].transpose) {
-                res.minorBoundaries.push_back(k);
-                // Cross-bond: rotate accumulated sheath history  A←C, C←B, B←A
-                for (int m = 0; m < k; ++m) {
-                    cd tmp      = res.E[m][0];
-                    res.E[m][0] = res.E[m][2];
-                    res.E[m][2] = res.E[m][1];
-                    res.E[m][1] = tmp;
+    res.sections.resize(route.size());
+    std::array<cd, 3> E0{};
+    double start       = 0.0;
+    int    firstSample = 1;      // sample 0 is the route start
+    if (from > 0) {
+        const auto& prev = res.sections[from - 1];
+        E0          = prev.Eend;
+        start       = prev.start_m + prev.length_m;
+        firstSample = prev.firstSample + prev.samples;
+    }
+
+    for (size_t s = from; s < route.size(); ++s) {
+        const auto& sec = route[s];
+        auto&       out = res.sections[s];
+
+        if (progress && s % kProgressStride == 0 &&
+            !progress(static_cast<double>(s) / route.size()))
+            return false;
+
+        if (s > 0 && sec.transpose) {
+            res.minorBoundaries.push_back(start);
+            rotatePhases(E0);
+        }
+
+        // validate() has bounded the total, so every count fits an int
+        out.samples     = static_cast<int>(sectionSteps(sec.length_m, params.step_m));
+        out.start_m     = start;
+        out.length_m    = sec.length_m;
+        out.firstSample = firstSample;
+        out.E0          = E0;
+        out.dE          = calcEpm(Ia, Ib, Ic,
+            sec.Sab_mm * 1e-3,
+            sec.Sbc_mm * 1e-3,
+            sec.Sac_mm * 1e-3,
+            params.frequency_Hz, params.formula);
+        out.Eend        = sampleAt(out.E0, out.dE, out.length_m);
+
+        for (int ph = 0; ph < 3; ++ph) {
+            const double v0 = magnitude(out.E0[ph]);
+            const double v1 = magnitude(out.Eend[ph]);
+            out.peak[ph]   = std::max(v0, v1);
+            out.peakAt[ph] = (v1 > v0) ? start + out.length_m : start;
+        }
+
+        E0           = out.Eend;
+        start       += out.length_m;
+        firstSample += out.samples;
+    }
+    res.totalLength = start;
+    return true;
+}
+
+static void rotateSection(SectionSolution& sec)
+{
+    rotatePhases(sec.E0);
+    rotatePhases(sec.dE);
+    rotatePhases(sec.Eend);
+    rotatePhases(sec.peak);
+    rotatePhases(sec.peakAt);
+}
+
+// ── Rotate into the final frame and reduce peaks ──────────────────────────────
+// Walk backwards so the number of downstream cross-bonds is known; that
+// count (mod 3) is the rotation each section's phasors still owe.  Sections
+// before `framed` are already in a final frame that assumed `framedRot`
+// cross-bonds from section `framed` on, so they owe only the difference.
+static void finalise(const std::vector<RouteSection>& route, SheathResults& res,
+                     size_t framed = 0, int framedRot = 0)
+{
+    int rot   = 0;
+    int delta = 0;
+    for (size_t s = route.size(); s-- > 0; ) {
+        auto& out = res.sections[s];
+        if (s + 1 == framed) delta = (rot - framedRot + 3) % 3;
+        const int owed = (s < framed) ? delta : rot;
+        for (int r = 0; r < owed; ++r) rotateSection(out);
+        if (s > 0 && route[s].transpose) rot = (rot + 1) % 3;
+
+        // >= so that, walking backwards, ties resolve to the earliest location
+        if (out.peak[0] >= res.maxVoltage_A) { res.maxVoltage_A = out.peak[0]; res.maxLocation_A = out.peakAt[0]; }
+        if (out.peak[1] >= res.maxVoltage_B) { res.maxVoltage_B = out.peak[1]; res.maxLocation_B = out.peakAt[1]; }
+        if (out.peak[2] >= res.maxVoltage_C) { res.maxVoltage_C = out.peak[2]; res.maxLocation_C = out.peakAt[2]; }
+    }
+    res.valid = true;
+}
+
+SheathResults solve(const SheathParams& params)
+{
+    SheathResults res;
+    if (!validate(params, res)) return res;
+    march(params, res, 0, {});
+    finalise(params.route, res);
+    return res;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// sectionKeys / solveIncremental
+// ─────────────────────────────────────────────────────────────────────────────
+std::vector<std::uint64_t> sectionKeys(const SheathParams& params)
+{
+    return sectionKeys(params, {}, 0);
+}
+
+std::vector<std::uint64_t> sectionKeys(const SheathParams& params,
+                                       const std::vector<std::uint64_t>& prior,
+                                       size_t from)
+{
+    from = std::min({ from, prior.size(), params.route.size() });
+
+    // FNV-1a carries all of its state in the hash, so a key is a valid seed
+    InputHash h;
+    if (from > 0) {
+        h = InputHash(prior[from - 1]);
+    } else {
+        h.add(params.current_A).add(params.frequency_Hz)
+         .add(static_cast<int>(params.formula)).add(params.step_m);
+    }
+
+    std::vector<std::uint64_t> keys;
+    keys.reserve(params.route.size());
+    keys.assign(prior.begin(), prior.begin() + from);
+    for (size_t s = from; s < params.route.size(); ++s) {
+        const auto& sec = params.route[s];
+        h.add(sec.length_m).add(sec.Sab_mm).add(sec.Sbc_mm).add(sec.Sac_mm)
+         .add(s > 0 && sec.transpose);   // the first section's flag is ignored
+        keys.push_back(h.value());
+    }
+    return keys;
+}
+
+SheathResults solveIncremental(const SheathParams& params,
+                               const std::vector<std::uint64_t>& keys,
+                               const SheathResults& prior,
+                               const std::vector<std::uint64_t>& priorKeys,
+                               size_t* reused,
+                               const Progress& progress)
+{
+    SheathResults res;
+    if (reused) *reused = 0;
+    if (!validate(params, res)) return res;
+
+    size_t k = 0;
+    if (prior.valid && keys.size() == params.route.size()) {
+        const size_t n = std::min({ keys.size(), priorKeys.size(), prior.sections.size() });
+        while (k < n && keys[k] == priorKeys[k]) ++k;
+    }
+
+    // The reused sections keep the final frame they had in `prior`, and
+    // finalise() applies only the difference the edit made to the cross-bonds
+    // downstream of them — usually none.  The last is taken back into the
+    // local frame, by finishing the rotation cycle it owed in `prior`, for
+    // the march to continue from.  minorBoundaries is ascending and holds the
+    // start of every transposed section, so those downstream of a section are
+    // the ones past its start.
+    res.sections.assign(prior.sections.begin(), prior.sections.begin() + k);
+    size_t framed    = 0;
+    int    framedRot = 0;
+    if (k > 0) {
+        const auto& bounds = prior.minorBoundaries;
+        auto&       last   = res.sections[k - 1];
+        const auto  past   = std::upper_bound(bounds.begin(), bounds.end(), last.start_m);
+        const int   owed   = static_cast<int>((bounds.end() - past) % 3);
+        for (int r = 0; r < (3 - owed) % 3; ++r) rotateSection(last);
+
+        framed    = k - 1;
+        framedRot = static_cast<int>((bounds.end() -
+            std::lower_bound(bounds.begin(), bounds.end(), last.start_m)) % 3);
+        for (size_t s = 1; s < k; ++s)
+            if (params.route[s].transpose) res.minorBoundaries.push_back(res.sections[s].start_m);
+    }
+
+    if (!march(params, res, k, progress)) {
+        res = {};
+        res.errorMsg = "Cancelled";
+        return res;
+    }
+    finalise(params.route, res, framed, framedRot);
+    if (reused) *reused = k;
+    return res;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// forEachSample
+// ─────────────────────────────────────────────────────────────────────────────
+bool forEachSample(const SheathResults& res, const SampleVisitor& visit,
+                   const Progress& progress)
+{
+    if (!res.valid) return true;
+
+    const auto&  last = res.sections.back();
+    const size_t n    = static_cast<size_t>(last.firstSample + last.samples);
+
+    visit(0.0, {});
+    size_t nextReport = 0;
+    for (const auto& sec : res.sections) {
+        if (progress && static_cast<size_t>(sec.firstSample) >= nextReport) {
+            if (!progress(static_cast<double>(sec.firstSample) / n)) return false;
+            nextReport = sec.firstSample + kProgressStride;
+        }
+        for (int j = 1; j <= sec.samples; ++j) {
+            const double t = sampleOffset(sec, j);
+            visit(sec.start_m + t, sampleAt(sec.E0, sec.dE, t));
+        }
+    }
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// envelope
+// ─────────────────────────────────────────────────────────────────────────────
+Envelope envelope(const SheathResults& res, int columns)
+{
+    Envelope env;
+    if (!res.valid || columns <= 0 || res.totalLength <= 0.0) return env;
+
+    env.columns = columns;
+    for (int ph = 0; ph < 3; ++ph) {
+        env.lo[ph].assign(columns,  std::numeric_limits<double>::infinity());
+        env.hi[ph].assign(columns, -std::numeric_limits<double>::infinity());
+    }
+
+    const double width = res.totalLength / columns;
+    auto column = [&](double m) {
+        return std::clamp(static_cast<int>(m / width), 0, columns - 1);
+    };
+
+    for (const auto& sec : res.sections) {
+        const int first = column(sec.start_m);
+        const int last  = column(sec.start_m + sec.length_m);
+
+        // Where |E0 + t·dE| bottoms out along the (unbounded) line
+        std::array<double, 3> tMin{};
+        for (int ph = 0; ph < 3; ++ph) {
+            const double dd = std::norm(sec.dE[ph]);
+            tMin[ph] = (dd > 0.0)
+                ? -(sec.E0[ph].real() * sec.dE[ph].real() +
+                    sec.E0[ph].imag() * sec.dE[ph].imag()) / dd
+                : 0.0;
+        }
+
+        for (int c = first; c <= last; ++c) {
+            // Part of the section inside column c, in section-local metres
+            const double a = std::max(0.0,          c * width - sec.start_m);
+            const double b = std::min(sec.length_m, (c + 1) * width - sec.start_m);
+            if (b < a) continue;
+
+            const auto Ea = sampleAt(sec.E0, sec.dE, a);
+            const auto Eb = sampleAt(sec.E0, sec.dE, b);
+            for (int ph = 0; ph < 3; ++ph) {
+                const double va = magnitude(Ea[ph]);
+                const double vb = magnitude(Eb[ph]);
+                const double t  = std::clamp(tMin[ph], a, b);
+                const double vt = magnitude(sec.E0[ph] + t * sec.dE[ph]);
+                env.lo[ph][c] = std::min({ env.lo[ph][c], va, vb, vt });
+                env.hi[ph][c] = std::max({ env.hi[ph][c], va, vb });
+            }
+        }
+    }
+
+    // A column can end up with no part of any section after rounding (b < a
+    // above).  |E| is continuous, so it takes the range of its neighbour:
+    // the column before, or for leading columns the first one filled.
+    int filled = -1;
+    for (int c = 0; c < columns; ++c) {
+        if (env.lo[0][c] <= env.hi[0][c]) {
+            if (filled < 0)
+                for (int ph = 0; ph < 3; ++ph)
+                    for (int k = 0; k < c; ++k) {
+                        env.lo[ph][k] = env.lo[ph][c];
+                        env.hi[ph][k] = env.hi[ph][c];
+                    }
+            filled = c;
+        } else if (filled >= 0) {
+            for (int ph = 0; ph < 3; ++ph) {
+                env.lo[ph][c] = env.lo[ph][c - 1];
+                env.hi[ph][c] = env.hi[ph][c - 1];
+            }
+        }
+    }
+    return env;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// expandProfile
+// ─────────────────────────────────────────────────────────────────────────────
+bool expandProfile(SheathResults& res, const Progress& progress)
+{
+    if (!res.valid) return true;
+
+    const auto&  last = res.sections.back();
+    const size_t n    = static_cast<size_t>(last.firstSample + last.samples);
+    res.x.assign(n, 0.0);
+    for (int ph = 0; ph < 3; ++ph) {
+        res.Ere [ph].assign(n, 0.0);
+        res.Eim [ph].assign(n, 0.0);
+        res.Emag[ph].assign(n, 0.0);
+    }
+
+    // Same arithmetic as sampleAt(), written per component so it lands
+    // straight in the split arrays.
+    size_t nextReport = 0;
+    for (const auto& sec : res.sections) {
+        if (progress && static_cast<size_t>(sec.firstSample) >= nextReport) {
+            if (!progress(static_cast<double>(sec.firstSample) / n)) {
+                res.x.clear();
+                for (int ph = 0; ph < 3; ++ph) {
+                    res.Ere[ph].clear();
+                    res.Eim[ph].clear();
+                    res.Emag[ph].clear();
                 }
+                return false;
+            }
+            nextReport = sec.firstSample + kProgressStride;
+        }
+        for (int j = 1; j <= sec.samples; ++j) {
+            const size_t k = static_cast<size_t>(sec.firstSample + j - 1);
+            const double t = sampleOffset(sec, j);
+            res.x[k] = sec.start_m + t;
+            for (int ph = 0; ph < 3; ++ph) {
+                res.Ere[ph][k] = sec.E0[ph].real() + t * sec.dE[ph].real();
+                res.Eim[ph][k] = sec.E0[ph].imag() + t * sec.dE[ph].imag();
             }
+        }
+    }
+
+    const MagnitudeKernel mag = magnitudeKernel();
+    for (int ph = 0; ph < 3; ++ph)
+        mag(res.Ere[ph].data(), res.Eim[ph].data(), res.Emag[ph].data(), n);
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// calculate
+// ─────────────────────────────────────────────────────────────────────────────
+SheathResults calculate(const SheathParams& params)
+{
+    SheathResults res = solve(params);
+    if (params.detail == SheathParams::Detail::PROFILE)
+        expandProfile(res);
+    return res;
+}
 
-            Epm = calcEpm(Ia, Ib, Ic,
-                route[sectionVal].Sab_mm * 1e-3,
-                route[sectionVal].Sbc_mm * 1e-3,
-                route[sectionVal].Sac_mm * 1e-3,
-                params.frequency_Hz, params.formula);
+// ─────────────────────────────────────────────────────────────────────────────
+// sweepCurrent / scaleCurrent
+// ─────────────────────────────────────────────────────────────────────────────
+SweepResults sweepCurrent(const SheathParams& params,
+                          const std::vector<double>& currents)
+{
+    SweepResults sweep;
+    for (size_t i = 0; i < currents.size(); ++i) {
+        if (currents[i] <= 0.0) {
+            sweep.errorMsg = "Sweep current " + std::to_string(i+1) + " must be > 0.";
+            return sweep;
         }
+    }
 
-        res.E[k] = {
-            res.E[k-1][0] + Epm[0],
-            res.E[k-1][1] + Epm[1],
-            res.E[k-1][2] + Epm[2]
-        };
+    SheathParams unitParams = params;
+    unitParams.current_A    = 1.0;
+    unitParams.detail       = SheathParams::Detail::SUMMARY;
+    sweep.unit = solve(unitParams);
+    if (!sweep.unit.valid) {
+        sweep.errorMsg = sweep.unit.errorMsg;
+        return sweep;
     }
 
-    // ── Magnitudes and peaks ──────────────────────────────────────────────────
-    for (int k = 0; k < totalLen; ++k) {
-        res.Emag[k][0] = std::abs(res.E[k][0]);
-        res.Emag[k][1] = std::abs(res.E[k][1]);
-        res.Emag[k][2] = std::abs(res.E[k][2]);
+    sweep.points.reserve(currents.size());
+    for (double I : currents) {
+        sweep.points.push_back({ I,
+            sweep.unit.maxVoltage_A * I,
+            sweep.unit.maxVoltage_B * I,
+            sweep.unit.maxVoltage_C * I });
+    }
+    sweep.valid = true;
+    return sweep;
+}
 
-        if (res.Emag[k][0] > res.maxVoltage_A) res.maxVoltage_A = res.Emag[k][0];
-        if (res.Emag[k][1] > res.maxVoltage_B) res.maxVoltage_B = res.Emag[k][1];
-        if (res.Emag[k][2] > res.maxVoltage_C) res.maxVoltage_C = res.Emag[k][2];
+SheathResults scaleCurrent(const SheathResults& unit, double current_A)
+{
+    SheathResults res = unit;
+    if (!res.valid) return res;
+
+    const double I = current_A;
+    for (auto& sec : res.sections) {
+        for (int ph = 0; ph < 3; ++ph) {
+            sec.E0  [ph] *= I;
+            sec.dE  [ph] *= I;
+            sec.Eend[ph] *= I;
+            sec.peak[ph] *= I;
+        }
     }
+    res.maxVoltage_A *= I;
+    res.maxVoltage_B *= I;
+    res.maxVoltage_C *= I;
 
-    res.valid = true;
+    // Any profile carried over from `unit` is stale now
+    res.x.clear();
+    for (int ph = 0; ph < 3; ++ph) {
+        res.Ere [ph].clear();
+        res.Eim [ph].clear();
+        res.Emag[ph].clear();
+    }
     return res;
 }
 
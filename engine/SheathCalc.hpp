@@ -11,6 +11,8 @@
 
 #include <array>
 #include <complex>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -46,33 +48,168 @@ struct SheathParams {
     //
     enum class Formula { SIMPLIFIED, FULL } formula = Formula::FULL;
 
+    // Profile sample spacing (m).  Each section is split into equal steps no
+    // longer than this, so section boundaries are always sampled exactly.
+    // Peak voltages are independent of the step.
+    double step_m = 1.0;
+
+    // Result detail:
+    //  SUMMARY — sections, peaks and peak locations only; memory O(sections).
+    //  PROFILE — additionally fill the sampled x/Ere/Eim/Emag profile.
+    enum class Detail { SUMMARY, PROFILE } detail = Detail::PROFILE;
+
     // Route sections — must be populated by the caller.
     std::vector<RouteSection> route;
 };
 
+// ── Closed-form solution for one section ─────────────────────────────────────
+// Within a section the induced EMF per metre is constant, so the sheath
+// voltage is linear in distance:  E(x) = E0 + (x − start_m)·dE.
+// E0 and dE are stored already rotated into the final (route-end) phase frame.
+struct SectionSolution {
+    double start_m  = 0.0;  // Distance from route start to the section start (m)
+    double length_m = 0.0;  // Exact section length (m)
+
+    int firstSample = 0;    // Profile index of the section's first sample
+    int samples     = 0;    // Profile samples in the section (the last is its end)
+
+    std::array<std::complex<double>, 3> E0{};    // Phasor at the section start
+    std::array<std::complex<double>, 3> dE{};    // Increment per metre (V/m)
+    std::array<std::complex<double>, 3> Eend{};  // Phasor at the section end
+
+    // |E| is convex along a section, so the peak always sits at one of its ends
+    std::array<double, 3> peak{};
+    std::array<double, 3> peakAt{};   // Distance from route start of each peak (m)
+};
+
 // ── Results ────────────────────────────────────────────────────────────────────
 struct SheathResults {
     bool   valid       = false;
-    int    totalLength = 0;
+    double totalLength = 0.0;   // Route length (m)
+
+    // One closed-form solution per route section (always populated when valid)
+    std::vector<SectionSolution> sections;
 
-    // Complex sheath voltage phasor at each metre: [metre][phase 0=A, 1=B, 2=C]
-    std::vector<std::array<std::complex<double>, 3>> E;
+    // Per-sample profile — only filled for Detail::PROFILE or by expandProfile().
+    // Sample 0 is the route start (E = 0); every section end is a sample.
+    std::vector<double> x;      // Distance from route start of each sample (m)
 
-    // Voltage magnitude at each metre: [metre][phase]
-    std::vector<std::array<double, 3>> Emag;
+    // Sheath voltage phasor at each sample, split into one contiguous array
+    // per component and phase: [phase 0=A, 1=B, 2=C][sample]
+    std::array<std::vector<double>, 3> Ere;
+    std::array<std::vector<double>, 3> Eim;
+
+    // Voltage magnitude at each sample: [phase][sample]
+    std::array<std::vector<double>, 3> Emag;
 
     // Distance from route start (metres) at each cross-bond transpose
-    std::vector<int> minorBoundaries;
+    std::vector<double> minorBoundaries;
 
     // Peak sheath voltage across the entire route, per phase (V)
     double maxVoltage_A = 0.0;
     double maxVoltage_B = 0.0;
     double maxVoltage_C = 0.0;
 
+    // Distance from route start of the first occurrence of each peak (m)
+    double maxLocation_A = 0.0;
+    double maxLocation_B = 0.0;
+    double maxLocation_C = 0.0;
+
     std::string errorMsg;
 };
 
+// ── Progress ──────────────────────────────────────────────────────────────────
+// Long-running calls report the fraction done (0–1) to an optional callback,
+// every few thousand sections or samples.  Returning false cancels the call.
+using Progress = std::function<bool(double fraction)>;
+
 // ── Public API ────────────────────────────────────────────────────────────────
+// Section-level solve: fills sections, minorBoundaries, peak voltages and
+// their locations but leaves the profile empty.  Cost depends on the number
+// of sections only.
+SheathResults solve(const SheathParams& params);
+
+// Produce the sampled x/Ere/Eim/Emag profile from a solved result.  Returns
+// false, leaving the profile empty, if `progress` cancelled it.
+bool expandProfile(SheathResults& res, const Progress& progress = {});
+
+// Stream every profile sample of a solved result, in route order, without
+// storing the profile.  Works on SUMMARY results.  Returns false, having
+// stopped part way, if `progress` cancelled it.
+using SampleVisitor =
+    std::function<void(double x, const std::array<std::complex<double>, 3>& E)>;
+bool forEachSample(const SheathResults& res, const SampleVisitor& visit,
+                   const Progress& progress = {});
+
+// |E| rounded exactly as the engine rounds peaks and profile magnitudes
+double magnitude(std::complex<double> v);
+
+// ── Plotting ──────────────────────────────────────────────────────────────────
+// |E| range per column for drawing the route `columns` wide: column c covers
+// distances [c, c+1) · totalLength / columns.  Built from the section
+// solutions, so it works on SUMMARY results and costs O(sections + columns)
+// whatever the route length.  |E| is convex along a section, so the range is
+// exact — section-end peaks always land in their column.  Every column is
+// filled, even one that rounding leaves with no part of a section.
+struct Envelope {
+    int columns = 0;
+    std::array<std::vector<double>, 3> lo;   // [phase][column]
+    std::array<std::vector<double>, 3> hi;
+};
+Envelope envelope(const SheathResults& res, int columns);
+
+// solve(), then expandProfile() when params.detail is PROFILE.
 SheathResults calculate(const SheathParams& params);
 
+// ── Incremental solve ─────────────────────────────────────────────────────────
+// A section's solution depends only on the system parameters and the route up
+// to and including it, so each section is keyed by a hash chained along the
+// route.  Labels are not part of the key.
+std::vector<std::uint64_t> sectionKeys(const SheathParams& params);
+
+// sectionKeys(params) when `prior` holds the keys of the same route before an
+// edit at section `from` or later: the chain resumes from prior[from - 1] so
+// only the sections from `from` on are hashed.  from == 0 hashes everything.
+std::vector<std::uint64_t> sectionKeys(const SheathParams& params,
+                                       const std::vector<std::uint64_t>& prior,
+                                       size_t from);
+
+// solve(params), reusing the leading sections of `prior` whose keys still
+// match; the march restarts at the first changed section.  `keys` is
+// sectionKeys(params), `priorKeys` those of the params `prior` was solved
+// from.  The result is identical to solve(params); `reused` (optional)
+// receives the number of sections taken from `prior`.  If `progress`
+// cancels, the result is invalid with errorMsg "Cancelled".
+SheathResults solveIncremental(const SheathParams& params,
+                               const std::vector<std::uint64_t>& keys,
+                               const SheathResults& prior,
+                               const std::vector<std::uint64_t>& priorKeys,
+                               size_t* reused = nullptr,
+                               const Progress& progress = {});
+
+// ── Current sweep ─────────────────────────────────────────────────────────────
+// Sheath EMF is linear in the load current, so the route is solved once at
+// 1 A and scaled.  Peak locations do not depend on current and live in `unit`.
+struct SweepPoint {
+    double current_A    = 0.0;
+    double maxVoltage_A = 0.0;
+    double maxVoltage_B = 0.0;
+    double maxVoltage_C = 0.0;
+};
+
+struct SweepResults {
+    bool valid = false;
+    SheathResults           unit;    // Route solved at 1 A (SUMMARY detail)
+    std::vector<SweepPoint> points;  // One per requested current, in order
+    std::string errorMsg;
+};
+
+// params.current_A and params.detail are ignored.
+SweepResults sweepCurrent(const SheathParams& params,
+                          const std::vector<double>& currents);
+
+// Full results for one load current from a 1 A solution; call
+// expandProfile() on the returned value if the profile is wanted.
+SheathResults scaleCurrent(const SheathResults& unit, double current_A);
+
 } // namespace sheath
@@ -0,0 +1,216 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// SheathMultiCalc.cpp
+// Multi-circuit sheath engine — same section march as SheathCalc.cpp with the
+// per-circuit Sab/Sbc/Sac formula replaced by a full coupling matrix.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "SheathMultiCalc.hpp"
+#include "SheathCalc.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sheath {
+
+using cd = std::complex<double>;
+static constexpr double PI = 3.14159265358979323846;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Coupling kernel — out[i] = jωμ·Σ_k L[i][k]·I[k]
+// L is the real M×M matrix of ln(1/d_ik), M = 3·circuits.  A non-zero `Fixed`
+// makes M a compile-time constant, which lets the compiler fully unroll the
+// common 1–4 circuit cases; Fixed == 0 takes M as given.
+// ─────────────────────────────────────────────────────────────────────────────
+template <int Fixed>
+static void coupleKernel(int M, const double* L, const cd* I, cd jwmu, cd* out)
+{
+    if (Fixed > 0) M = Fixed;
+    for (int i = 0; i < M; ++i) {
+        double re = 0.0, im = 0.0;
+        for (int k = 0; k < M; ++k) {
+            re += L[i * M + k] * I[k].real();
+            im += L[i * M + k] * I[k].imag();
+        }
+        out[i] = jwmu * cd(re, im);
+    }
+}
+
+static void couple(int M, const double* L, const cd* I, cd jwmu, cd* out)
+{
+    switch (M) {
+    case 3:  coupleKernel<3> (M, L, I, jwmu, out); break;
+    case 6:  coupleKernel<6> (M, L, I, jwmu, out); break;
+    case 9:  coupleKernel<9> (M, L, I, jwmu, out); break;
+    case 12: coupleKernel<12>(M, L, I, jwmu, out); break;
+    default: coupleKernel<0> (M, L, I, jwmu, out); break;
+    }
+}
+
+// Fill L (M×M, row-major) with ln(1/d_ik) for one section.  Symmetric, so
+// only the upper triangle costs a log.  Returns false if two cables coincide.
+static bool buildCoupling(const MultiRouteSection& sec, std::vector<double>& L)
+{
+    const int M = static_cast<int>(sec.cables.size()) * 3;
+    L.assign(static_cast<size_t>(M) * M, 0.0);
+
+    auto pos = [&](int i) -> const CablePosition& {
+        return sec.cables[i / 3][i % 3];
+    };
+
+    const double selfTerm = -std::log(sec.sheathDiameter_mm * 0.5e-3);
+    for (int i = 0; i < M; ++i) {
+        L[i * M + i] = selfTerm;
+        for (int k = i + 1; k < M; ++k) {
+            const double d = std::hypot(pos(i).x_mm - pos(k).x_mm,
+                                        pos(i).y_mm - pos(k).y_mm) * 1e-3;
+            if (d <= 0.0) return false;
+            L[i * M + k] = L[k * M + i] = -std::log(d);
+        }
+    }
+    return true;
+}
+
+// Cross-bond transpose of every circuit  A←C, C←B, B←A
+template <typename T>
+static void rotateCircuits(std::vector<T>& v)
+{
+    for (size_t c = 0; c + 2 < v.size(); c += 3) {
+        T tmp    = v[c + 0];
+        v[c + 0] = v[c + 2];
+        v[c + 2] = v[c + 1];
+        v[c + 1] = tmp;
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// calculateMulti
+// ─────────────────────────────────────────────────────────────────────────────
+MultiSheathResults calculateMulti(const MultiSheathParams& params)
+{
+    MultiSheathResults res;
+    const auto& route = params.route;
+    const int   N     = static_cast<int>(params.current_A.size());
+    const int   M     = 3 * N;
+
+    // ── Validation ────────────────────────────────────────────────────────────
+    if (route.empty()) {
+        res.errorMsg = "Route is empty — add at least one section.";
+        return res;
+    }
+    if (N == 0) {
+        res.errorMsg = "At least one circuit is required.";
+        return res;
+    }
+    for (int c = 0; c < N; ++c) {
+        if (params.current_A[c] <= 0.0) {
+            res.errorMsg = "Circuit " + std::to_string(c+1) + ": current must be > 0.";
+            return res;
+        }
+    }
+    if (!params.phaseShift_deg.empty() &&
+        static_cast<int>(params.phaseShift_deg.size()) != N) {
+        res.errorMsg = "Phase shifts must be given for every circuit or none.";
+        return res;
+    }
+    for (size_t i = 0; i < route.size(); ++i) {
+        if (route[i].length_m <= 0.0) {
+            res.errorMsg = "Section " + std::to_string(i+1) + ": length must be > 0.";
+            return res;
+        }
+        if (route[i].sheathDiameter_mm <= 0.0) {
+            res.errorMsg = "Section " + std::to_string(i+1) + ": sheath diameter must be > 0.";
+            return res;
+        }
+        if (static_cast<int>(route[i].cables.size()) != N) {
+            res.errorMsg = "Section " + std::to_string(i+1) + ": expected "
+                         + std::to_string(N) + " circuit(s).";
+            return res;
+        }
+    }
+
+    // Current phasors per circuit — same convention as calculate():
+    //   Ia = a·I, Ib = I, Ic = a²·I, rotated by the circuit's phase shift
+    const cd a(-0.5, std::sqrt(3.0) / 2.0);
+    std::vector<cd> I(M);
+    for (int c = 0; c < N; ++c) {
+        const double shift = params.phaseShift_deg.empty()
+                           ? 0.0 : params.phaseShift_deg[c] * PI / 180.0;
+        const cd I0 = std::polar(params.current_A[c], shift);
+        I[3*c + 0] = a     * I0;
+        I[3*c + 1] =         I0;
+        I[3*c + 2] = (a*a) * I0;
+    }
+    const cd jwmu(0.0, 2.0 * PI * params.frequency_Hz * 2e-7);   // jω·μ₀/(2π)
+
+    // ── Section march (local frame) ───────────────────────────────────────────
+    res.circuits = N;
+    res.sections.resize(route.size());
+    std::vector<double> L;
+    std::vector<cd>     E0(M);
+    double start = 0.0;
+
+    for (size_t s = 0; s < route.size(); ++s) {
+        const auto& sec = route[s];
+        auto&       out = res.sections[s];
+
+        if (!buildCoupling(sec, L)) {
+            res = MultiSheathResults{};
+            res.errorMsg = "Section " + std::to_string(s+1) + ": two cables share a position.";
+            return res;
+        }
+
+        if (s > 0 && sec.transpose) {
+            res.minorBoundaries.push_back(start);
+            rotateCircuits(E0);
+        }
+
+        out.start_m  = start;
+        out.length_m = sec.length_m;
+        out.E0       = E0;
+        out.dE.resize(M);
+        couple(M, L.data(), I.data(), jwmu, out.dE.data());
+
+        out.Eend  .resize(M);
+        out.peak  .resize(M);
+        out.peakAt.resize(M);
+        for (int i = 0; i < M; ++i) {
+            out.Eend[i] = out.E0[i] + sec.length_m * out.dE[i];
+            const double v0 = magnitude(out.E0[i]);   // Rounds as the single-circuit engine does
+            const double v1 = magnitude(out.Eend[i]);
+            out.peak[i]   = std::max(v0, v1);
+            out.peakAt[i] = (v1 > v0) ? start + sec.length_m : start;
+        }
+
+        E0     = out.Eend;
+        start += sec.length_m;
+    }
+    res.totalLength = start;
+
+    // ── Rotate into the final frame and reduce peaks ──────────────────────────
+    res.maxVoltage .assign(N, {});
+    res.maxLocation.assign(N, {});
+    int rot = 0;
+    for (size_t s = route.size(); s-- > 0; ) {
+        auto& out = res.sections[s];
+        for (int r = 0; r < rot; ++r) {
+            rotateCircuits(out.E0);
+            rotateCircuits(out.dE);
+            rotateCircuits(out.Eend);
+            rotateCircuits(out.peak);
+            rotateCircuits(out.peakAt);
+        }
+        if (s > 0 && route[s].transpose) rot = (rot + 1) % 3;
+
+        // >= so that, walking backwards, ties resolve to the earliest location
+        for (int i = 0; i < M; ++i) {
+            if (out.peak[i] >= res.maxVoltage[i / 3][i % 3]) {
+                res.maxVoltage [i / 3][i % 3] = out.peak[i];
+                res.maxLocation[i / 3][i % 3] = out.peakAt[i];
+            }
+        }
+    }
+
+    res.valid = true;
+    return res;
+}
+
+} // namespace sheath
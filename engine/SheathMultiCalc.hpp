@@ -0,0 +1,86 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+// SheathMultiCalc.hpp
+// Sheath voltage rise for N three-phase circuits sharing a trench, with full
+// mutual coupling between every phase of every circuit.
+//
+// Each section builds the 3N×3N mutual-inductance matrix from cable positions
+//   E_i = jω·(μ₀/2π)·Σ_k I_k·ln(1/d_ik)      (d_ii = mean sheath radius)
+// Every circuit carries a balanced set of currents, so the reference distance
+// cancels.  With one circuit and d_ii = Sab/2 this reproduces the per-metre
+// EMF magnitudes of SheathParams::Formula::FULL; phase angles follow directly
+// from the currents, so peaks after cross-bonding can differ from calculate().
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <array>
+#include <complex>
+#include <string>
+#include <vector>
+
+namespace sheath {
+
+// ── Cable centre in the trench cross-section ─────────────────────────────────
+struct CablePosition {
+    double x_mm = 0.0;   // Horizontal position (mm)
+    double y_mm = 0.0;   // Vertical position, e.g. depth (mm)
+};
+
+// ── One section of a multi-circuit route ─────────────────────────────────────
+struct MultiRouteSection {
+    double length_m          = 10.0;  // Section length (metres)
+    double sheathDiameter_mm = 0.0;   // Mean sheath diameter (mm)
+
+    // Cable positions: [circuit][phase 0=A, 1=B, 2=C]
+    std::vector<std::array<CablePosition, 3>> cables;
+
+    bool        transpose = false;    // Cross-bond every circuit at section start
+    std::string label;                // Free-form description (optional)
+};
+
+// ── System parameters ─────────────────────────────────────────────────────────
+struct MultiSheathParams {
+    double frequency_Hz = 50.0;       // Power system frequency (Hz)
+
+    std::vector<double> current_A;       // Load current per circuit (A, RMS)
+    std::vector<double> phaseShift_deg;  // Optional per-circuit angle (deg)
+
+    // Route sections — every section must list one entry per circuit.
+    std::vector<MultiRouteSection> route;
+};
+
+// ── Closed-form solution for one section ─────────────────────────────────────
+// Same form as SectionSolution, flattened over [circuit·3 + phase].
+struct MultiSectionSolution {
+    double start_m  = 0.0;
+    double length_m = 0.0;
+
+    std::vector<std::complex<double>> E0;    // Phasor at the section start
+    std::vector<std::complex<double>> dE;    // Increment per metre (V/m)
+    std::vector<std::complex<double>> Eend;  // Phasor at the section end
+
+    std::vector<double> peak;                // Max |E| within the section
+    std::vector<double> peakAt;              // Distance from route start (m)
+};
+
+// ── Results ────────────────────────────────────────────────────────────────────
+struct MultiSheathResults {
+    bool   valid       = false;
+    int    circuits    = 0;
+    double totalLength = 0.0;   // Route length (m)
+
+    std::vector<MultiSectionSolution> sections;
+
+    // Distance from route start (metres) at each cross-bond transpose
+    std::vector<double> minorBoundaries;
+
+    // Peak sheath voltage and its first location, per circuit and phase
+    std::vector<std::array<double, 3>> maxVoltage;
+    std::vector<std::array<double, 3>> maxLocation;
+
+    std::string errorMsg;
+};
+
+// ── Public API ────────────────────────────────────────────────────────────────
+MultiSheathResults calculateMulti(const MultiSheathParams& params);
+
+} // namespace sheath
@@ -0,0 +1,175 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// BackgroundWorker
+//   One thread that runs calculation jobs off the UI thread, newest first:
+//   starting a job cancels the one running and replaces any still queued, so
+//   only the latest request ever finishes.
+//
+//   Jobs get a Context to report progress and poll for cancellation.  The
+//   worker calls `wake` (from its own thread) whenever there is something
+//   new to draw — progress moved or a job ended; with FTXUI that is
+//   screen.PostEvent(Event::Custom).
+//
+//   Jobs hand their results back to the UI thread themselves, e.g. with
+//   screen.Post().  Cancellation happens on the UI thread, so the posted
+//   closure checks its Token there: a job superseded after it finished but
+//   before the closure ran is still discarded.  For that the worker keeps
+//   the state of the last job started, finished or not, until the next
+//   start() or cancel() marks it cancelled.
+// ─────────────────────────────────────────────────────────────────────────────
+class BackgroundWorker
+{
+    struct JobState {
+        std::atomic<bool> cancelled{ false };
+        std::atomic<int>  permille{ 0 };
+    };
+
+public:
+    // Cancellation flag of one job, safe to copy into posted closures
+    class Token
+    {
+    public:
+        bool cancelled() const { return m_state->cancelled.load(); }
+
+    private:
+        friend class BackgroundWorker;
+        explicit Token(std::shared_ptr<const JobState> state) : m_state(std::move(state)) {}
+        std::shared_ptr<const JobState> m_state;
+    };
+
+    class Context
+    {
+    public:
+        bool  cancelled() const { return m_state->cancelled.load(); }
+        Token token()     const { return Token(m_state); }
+
+        // Report the fraction done (0–1).  Returns false once the job has
+        // been cancelled, so it can be passed straight to engine callbacks.
+        bool progress(double fraction)
+        {
+            const int permille = static_cast<int>(std::clamp(fraction, 0.0, 1.0) * 1000.0);
+            if (m_state->permille.exchange(permille) / 10 != permille / 10 && m_wake)
+                m_wake();   // Redraw at most once per percent
+            return !cancelled();
+        }
+
+    private:
+        friend class BackgroundWorker;
+        Context(std::shared_ptr<JobState> state, const std::function<void()>& wake)
+            : m_state(std::move(state)), m_wake(wake) {}
+
+        std::shared_ptr<JobState>    m_state;
+        const std::function<void()>& m_wake;
+    };
+
+    using Job = std::function<void(Context&)>;
+
+    explicit BackgroundWorker(std::function<void()> wake = {})
+        : m_wake(std::move(wake))
+        , m_thread([this] { loop(); })
+    {}
+
+    ~BackgroundWorker()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+            cancelLatest();
+        }
+        m_queued.notify_one();
+        m_thread.join();
+    }
+
+    // Non-copyable
+    BackgroundWorker(const BackgroundWorker&)            = delete;
+    BackgroundWorker& operator=(const BackgroundWorker&) = delete;
+
+    // Queue `job`, cancelling the previous one — queued, running, or
+    // finished with its results still to be applied
+    void start(Job job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            cancelLatest();
+            m_pending      = std::move(job);
+            m_pendingState = std::make_shared<JobState>();
+            m_latest       = m_pendingState;
+        }
+        m_queued.notify_one();
+    }
+
+    void cancel()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        cancelLatest();
+    }
+
+    // True while a job is queued, or running and not cancelled
+    bool busy() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_pending || (m_running && !m_running->cancelled);
+    }
+
+    // Progress of the running job (0–1); 0 when idle
+    double progress() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_running ? m_running->permille / 1000.0 : 0.0;
+    }
+
+private:
+    // Caller holds m_mutex
+    void cancelLatest()
+    {
+        m_pending      = {};
+        m_pendingState = {};
+        if (m_latest) m_latest->cancelled = true;
+        m_latest.reset();
+    }
+
+    void loop()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            m_queued.wait(lock, [this] { return m_stop || m_pending; });
+            if (m_stop) return;
+
+            Job job        = std::move(m_pending);
+            m_pending      = {};
+            m_running      = std::move(m_pendingState);
+            m_pendingState = {};
+            Context ctx(m_running, m_wake);
+
+            lock.unlock();
+            job(ctx);
+            lock.lock();
+
+            m_running.reset();
+            if (m_wake) {
+                lock.unlock();
+                m_wake();
+                lock.lock();
+            }
+        }
+    }
+
+    std::function<void()>     m_wake;
+    mutable std::mutex        m_mutex;
+    std::condition_variable   m_queued;
+    Job                       m_pending;
+    std::shared_ptr<JobState> m_pendingState;
+    std::shared_ptr<JobState> m_running;
+    std::shared_ptr<JobState> m_latest;   // Last job started; cancelled by the next start()
+    bool                      m_stop = false;
+    std::thread               m_thread;   // Last, so it starts after the rest
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include <ftxui/dom/elements.hpp>
+
+#include <utility>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// ElementCache
+//   Holds one built Element and returns it again for as long as its key is
+//   unchanged, so a renderer only rebuilds (and re-formats) its element when
+//   the state it shows has moved on.  FTXUI lays the tree out afresh every
+//   frame, so a cached element still fits whatever space it is given; the
+//   key only needs what the build itself reads.
+//
+//   Key is any equality-comparable value — typically a version counter that
+//   is bumped wherever the shown state changes, or a std::tuple of them.
+// ─────────────────────────────────────────────────────────────────────────────
+template <typename Key>
+class ElementCache
+{
+public:
+    template <typename Build>
+    ftxui::Element get(const Key& key, Build&& build)
+    {
+        if (!m_element || !(key == m_key)) {
+            m_element = std::forward<Build>(build)();
+            m_key     = key;
+        }
+        return m_element;
+    }
+
+    void clear() { m_element = nullptr; }
+
+private:
+    Key            m_key{};
+    ftxui::Element m_element;
+};
@@ -0,0 +1,148 @@
+#pragma once
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Number formatting
+//   Writes straight into caller buffers with std::to_chars — no streams, no
+//   locale, no heap.  The std::string helpers return strings short enough
+//   for the small-string buffer, so UI cells do not allocate either.
+//
+//   Standard libraries without floating-point to_chars (Apple libc++ before
+//   macOS 13.3) fall back to snprintf into the same buffers.
+// ─────────────────────────────────────────────────────────────────────────────
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#  define CABLE_FLOAT_TO_CHARS 1
+#endif
+
+namespace format {
+
+// Large enough for any double in fixed notation up to 17 decimals
+constexpr size_t kMaxChars = 352;
+
+// `v` with exactly `dp` decimals, as std::fixed << setprecision(dp) would.
+// Returns one past the last character written, or `first` if it did not fit.
+inline char* fixed(char* first, char* last, double v, int dp)
+{
+#ifdef CABLE_FLOAT_TO_CHARS
+    const auto r = std::to_chars(first, last, v, std::chars_format::fixed, dp);
+    return r.ec == std::errc() ? r.ptr : first;
+#else
+    const int n = std::snprintf(first, static_cast<size_t>(last - first), "%.*f", dp, v);
+    return (n >= 0 && n < last - first) ? first + n : first;
+#endif
+}
+
+// Shortest text that parses back to exactly `v`
+inline char* shortest(char* first, char* last, double v)
+{
+#ifdef CABLE_FLOAT_TO_CHARS
+    const auto r = std::to_chars(first, last, v);
+    return r.ec == std::errc() ? r.ptr : first;
+#else
+    const size_t cap = static_cast<size_t>(last - first);
+    int n = std::snprintf(first, cap, "%.15g", v);
+    if (n >= 0 && static_cast<size_t>(n) < cap && std::strtod(first, nullptr) != v)
+        n = std::snprintf(first, cap, "%.17g", v);
+    return (n >= 0 && static_cast<size_t>(n) < cap) ? first + n : first;
+#endif
+}
+
+inline std::string fixed(double v, int dp)
+{
+    char buf[kMaxChars];
+    return std::string(buf, fixed(buf, buf + sizeof(buf), v, dp));
+}
+
+inline std::string shortest(double v)
+{
+    char buf[kMaxChars];
+    return std::string(buf, shortest(buf, buf + sizeof(buf), v));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// CsvWriter
+//   Buffered CSV output for bulk exports: fields are formatted into a fixed
+//   heap buffer that is written out whenever it fills.  Check ok() (or the result
+//   of flush()) once at the end rather than after every field.
+// ─────────────────────────────────────────────────────────────────────────────
+class CsvWriter
+{
+public:
+    static constexpr size_t kBufferSize = size_t(1) << 16;
+
+    explicit CsvWriter(std::FILE* file)
+        : m_file(file), m_buf(std::make_unique<char[]>(kBufferSize)) {}
+    ~CsvWriter() { flush(); }
+
+    // Non-copyable
+    CsvWriter(const CsvWriter&)            = delete;
+    CsvWriter& operator=(const CsvWriter&) = delete;
+
+    void field(double v, int dp)
+    {
+        separate();
+        reserve(kMaxChars);
+        m_len = static_cast<size_t>(fixed(m_buf.get() + m_len, m_buf.get() + kBufferSize, v, dp)
+                                    - m_buf.get());
+    }
+
+    // Written as is — the caller keeps commas and quotes out of it
+    void field(std::string_view s)
+    {
+        separate();
+        reserve(s.size());
+        if (s.size() > kBufferSize - m_len) {   // Longer than the whole buffer
+            m_ok = m_ok && std::fwrite(s.data(), 1, s.size(), m_file) == s.size();
+            return;
+        }
+        std::memcpy(m_buf.get() + m_len, s.data(), s.size());
+        m_len += s.size();
+    }
+
+    void endRow()
+    {
+        reserve(1);
+        m_buf[m_len++] = '\n';
+        m_first = true;
+    }
+
+    bool flush()
+    {
+        if (m_len > 0) {
+            m_ok  = m_ok && std::fwrite(m_buf.get(), 1, m_len, m_file) == m_len;
+            m_len = 0;
+        }
+        return m_ok;
+    }
+
+    bool ok() const { return m_ok; }
+
+private:
+    void separate()
+    {
+        if (!m_first) {
+            reserve(1);
+            m_buf[m_len++] = ',';
+        }
+        m_first = false;
+    }
+
+    void reserve(size_t n)
+    {
+        if (kBufferSize - m_len < n) flush();
+    }
+
+    std::FILE*              m_file;
+    std::unique_ptr<char[]> m_buf;
+    size_t                  m_len   = 0;
+    bool                    m_first = true;
+    bool                    m_ok    = true;
+};
+
+} // namespace format
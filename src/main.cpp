@@ -1,6 +1,13 @@
+#include "Ampacity.h"
+#include "BackgroundWorker.h"
 #include "CableData.h"
 #include "Calculator.h"
+#include "CatalogueImport.h"
+#include "CatalogueSnapshot.h"
 #include "DatabaseManager.h"
+#include "ElementCache.h"
+#include "Format.h"
+#include "Optimiser.h"
 #include "SheathCalc.hpp"
 
 #include <ftxui/component/component.hpp>
@@ -11,24 +18,32 @@
 #include <ftxui/screen/color.hpp>
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
 #include <functional>
-#include <iomanip>
-#include <sstream>
+#include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
 using namespace ftxui;
 
 // ── Formatting helpers ────────────────────────────────────────────────────────
 static std::string fmt(double v, int dp = 4) {
-    std::ostringstream ss;
-    ss << std::fixed << std::setprecision(dp) << v;
-    return ss.str();
+    return format::fixed(v, dp);
 }
 static std::string fmtOpt(double v, int dp = 4) {
     return (v < 0) ? "  -  " : fmt(v, dp);
 }
+// Shortest text that parses back to exactly v, for refilling input fields
+static std::string fmtInput(double v) {
+    return format::shortest(v);
+}
 
 // ── Cable Data table element ──────────────────────────────────────────────────
 static Element makeCableTable(const std::vector<CableRecord>& records)
@@ -100,9 +115,20 @@ static Element makeCableTable(const std::vector<CableRecord>& records)
     return table.Render() | vscroll_indicator | frame | flex;
 }
 
+// ── Arrangement display name ──────────────────────────────────────────────────
+static const char* arrangementName(Arrangement a)
+{
+    switch (a) {
+    case Arrangement::TrefoilTouching: return "Trefoil Touching";
+    case Arrangement::FlatTouching:    return "Flat Touching";
+    case Arrangement::FlatSpaced:      return "Flat Spaced";
+    }
+    return "";
+}
+
 // ── Output panel ──────────────────────────────────────────────────────────────
 static Element makeOutputPanel(const CalcResults& r, const SystemParams& p,
-                                bool calculated)
+                                const AmpacityResult& rating, bool calculated)
 {
     if (!calculated) {
         return window(
@@ -111,10 +137,7 @@ static Element makeOutputPanel(const CalcResults& r, const SystemParams& p,
         ) | flex;
     }
 
-    const std::string arrName =
-        (p.arrangement == Arrangement::TrefoilTouching) ? "Trefoil Touching" :
-        (p.arrangement == Arrangement::FlatTouching)    ? "Flat Touching"    :
-                                                          "Flat Spaced";
+    const std::string arrName = arrangementName(p.arrangement);
 
     auto row = [](const std::string& lbl, const std::string& val,
                   const std::string& unit = "") {
@@ -131,6 +154,10 @@ static Element makeOutputPanel(const CalcResults& r, const SystemParams& p,
         return hbox({ text("--- " + title + " ") | color(Color::Cyan), filler() });
     };
 
+    const double utilisation = (rating.rating_A > 0.0)
+                             ? r.current / rating.rating_A * 100.0 : 0.0;
+    const bool   overloaded  = rating.rating_A <= 0.0 || utilisation > 100.0;
+
     return window(
         text(" Calculated Outputs "),
         vbox({
@@ -148,6 +175,20 @@ static Element makeOutputPanel(const CalcResults& r, const SystemParams& p,
             row("Reactive power",    fmt(r.Q_Mvar,   3),  "Mvar"),
             row("Full-load current", fmt(r.current,  1),  "A"),
             separator(),
+            section("Rating (IEC 60287)"),
+            row("Continuous rating", fmt(rating.rating_A, 0), "A"),
+            hbox({
+                text("  Utilisation") | dim,
+                filler(),
+                text(fmt(utilisation, 1)) | bold
+                    | color(overloaded ? Color::Red : Color::Green),
+                text(" %") | dim,
+                text("  "),
+            }),
+            row("T1 / T3 / T4", fmt(rating.T1, 3) + " / " + fmt(rating.T3, 3) + " / "
+                                + fmt(rating.T4, 3), "K.m/W"),
+            row("Screen loss factor", fmt(rating.lambda1, 3)),
+            separator(),
             section("Voltage Drop"),
             row("dV (L-L)",  fmt(r.deltaV_V,   1), "V"),
             row("dV",        fmt(r.deltaV_pct, 2), "%"),
@@ -165,6 +206,52 @@ static Element makeOutputPanel(const CalcResults& r, const SystemParams& p,
     ) | flex;
 }
 
+// ── Optimiser panel ───────────────────────────────────────────────────────────
+static Element makeOptimiserPanel(const OptimiserResult& opt,
+                                  const OptimiserConstraints& limits)
+{
+    Elements rows;
+    rows.push_back(hbox({
+        text("  Limits: dV <= " + fmt(limits.maxDeltaV_pct, 2) + " %   losses <= "
+             + fmt(limits.maxLosses_pct, 2) + " %") | dim,
+        filler(),
+        text(std::to_string(opt.evaluated) + " of " + std::to_string(opt.searched)
+             + " evaluated  ") | dim,
+    }));
+    rows.push_back(separator());
+
+    if (opt.feasible.empty()) {
+        rows.push_back(text("  No size / arrangement meets the limits.") | color(Color::Red));
+        return window(text(" Optimiser "), vbox(rows) | flex) | flex;
+    }
+
+    auto cell = [](const std::string& s, int w) {
+        return text(s) | align_right | size(WIDTH, EQUAL, w);
+    };
+    rows.push_back(hbox({
+        cell("#", 4), cell("mm2", 7), text("  Arrangement") | size(WIDTH, EQUAL, 20),
+        cell("dV %", 8), cell("Loss %", 9), cell("Loss kW", 10), cell("Z Ohm", 9),
+    }) | bold);
+
+    for (size_t i = 0; i < opt.feasible.size(); ++i) {
+        const auto& c = opt.feasible[i];
+        Element row = hbox({
+            cell(std::to_string(i + 1), 4),
+            cell(std::to_string(c.sizeMm2), 7),
+            text(std::string("  ") + arrangementName(c.arrangement)) | size(WIDTH, EQUAL, 20),
+            cell(fmt(c.results.deltaV_pct, 2), 8),
+            cell(fmt(c.results.losses_pct, 2), 9),
+            cell(fmt(c.results.losses_kW, 1), 10),
+            cell(fmt(c.results.Z, 4), 9),
+        });
+        if (i == 0) row = row | color(Color::Green);
+        rows.push_back(row);
+    }
+
+    return window(text(" Optimiser - ranked feasible set "),
+                  vbox(rows) | vscroll_indicator | frame | flex) | flex;
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Arrangement helper — UI only.
 // Trefoil: Sab=Sbc=Sac=pitch
@@ -222,7 +309,7 @@ svSpacings(SvArr arr, double pitch)
 static Element makeSheathGraph(const sheath::SheathResults& res,
                                 int graphWidth, int graphHeight)
 {
-    if (!res.valid || res.totalLength == 0)
+    if (!res.valid || res.totalLength <= 0.0)
         return vbox({
             filler(),
             text("  No results — press [Calculate]") | dim | center,
@@ -253,8 +340,9 @@ static Element makeSheathGraph(const sheath::SheathResults& res,
     const double tickStep = niceStep(yMax, nTicks);
     const double yTop    = tickStep * std::ceil(yMax / tickStep);
 
-    auto px = [&](int    m) -> int { return static_cast<int>(
-        static_cast<double>(m) / res.totalLength * (CW - 1)); };
+    // Same column mapping as sheath::envelope(res, CW)
+    auto px = [&](double m) -> int { return std::min(CW - 1, static_cast<int>(
+        m / res.totalLength * CW)); };
     auto py = [&](double v) -> int { return static_cast<int>(
         (1.0 - v / yTop) * (CH - 1)); };
 
@@ -277,7 +365,7 @@ static Element makeSheathGraph(const sheath::SheathResults& res,
     }
 
     // ── Cross-bond / minor boundary markers ──────────────────────────────────
-    for (int mb : res.minorBoundaries) {
+    for (double mb : res.minorBoundaries) {
         int x = px(mb);
         // Dashed vertical — every other braille row
         for (int y = 0; y < CH; y += 2)
@@ -288,17 +376,24 @@ static Element makeSheathGraph(const sheath::SheathResults& res,
     }
 
     // ── Phase curves ─────────────────────────────────────────────────────────
-    // Unrolled to avoid MSVC C2676 on std::array subscript inside lambda.
-    for (int m = 1; m < res.totalLength; ++m) {
-        double v0a = std::get<0>(res.Emag[m - 1]);
-        double v0b = std::get<1>(res.Emag[m - 1]);
-        double v0c = std::get<2>(res.Emag[m - 1]);
-        double v1a = std::get<0>(res.Emag[m]);
-        double v1b = std::get<1>(res.Emag[m]);
-        double v1c = std::get<2>(res.Emag[m]);
-        c.DrawPointLine(px(m-1), py(v0a), px(m), py(v1a), Color::Cyan);
-        c.DrawPointLine(px(m-1), py(v0b), px(m), py(v1b), Color::Yellow);
-        c.DrawPointLine(px(m-1), py(v0c), px(m), py(v1c), Color::Magenta);
+    // One vertical min–max stroke per pixel column, so the cost follows the
+    // canvas width rather than the route length and no peak is dropped.
+    // Each stroke is stretched to meet its left neighbour so steep stretches
+    // stay continuous.
+    const sheath::Envelope env = sheath::envelope(res, CW);
+    const Color phaseCol[3] = { Color::Cyan, Color::Yellow, Color::Magenta };
+    for (int ph = 0; ph < 3; ++ph) {
+        const auto& lo = env.lo[ph];
+        const auto& hi = env.hi[ph];
+        for (int x = 0; x < env.columns; ++x) {
+            double top = hi[x];
+            double bot = lo[x];
+            if (x > 0) {
+                top = std::max(top, lo[x - 1]);
+                bot = std::min(bot, hi[x - 1]);
+            }
+            c.DrawPointLine(x, py(top), x, py(bot), phaseCol[ph]);
+        }
     }
 
     // ── Y-axis label column ───────────────────────────────────────────────────
@@ -308,9 +403,7 @@ static Element makeSheathGraph(const sheath::SheathResults& res,
     Elements yAxis;
     // Top label
     {
-        std::ostringstream s;
-        s << std::fixed << std::setprecision(0) << yTop << "V";
-        std::string lbl = s.str();
+        std::string lbl = fmt(yTop, 0) + "V";
         while ((int)lbl.size() < yLabelW - 1) lbl = " " + lbl;
         yAxis.push_back(text(lbl + "|") | color(Color::GrayDark));
     }
@@ -319,9 +412,7 @@ static Element makeSheathGraph(const sheath::SheathResults& res,
         double v = tickStep * t;
         // filler proportional to the gap between this tick and the one above
         yAxis.push_back(filler());
-        std::ostringstream s;
-        s << std::fixed << std::setprecision(0) << v << "V";
-        std::string lbl = s.str();
+        std::string lbl = fmt(v, 0) + "V";
         while ((int)lbl.size() < yLabelW - 1) lbl = " " + lbl;
         yAxis.push_back(text(lbl + "|") | color(Color::GrayDark));
     }
@@ -339,10 +430,11 @@ static Element makeSheathGraph(const sheath::SheathResults& res,
     xLabels.push_back(text(std::string(yLabelW, ' ')));  // blank under Y axis
     int lastLabelEnd = 0;
     for (int t = 0; t <= xTicks; ++t) {
-        int m = res.totalLength * t / xTicks;
-        int cellX = yLabelW + (m * (graphWidth - yLabelW)) / res.totalLength;
+        double m = res.totalLength * t / xTicks;
+        int cellX = yLabelW + static_cast<int>(
+            m * (graphWidth - yLabelW) / res.totalLength);
 
-        std::string lbl = std::to_string(m) + "m";
+        std::string lbl = fmt(m, 0) + "m";
         int lblW = static_cast<int>(lbl.size());
 
         // Pad to reach cellX from end of last label, avoid overlap
@@ -362,8 +454,7 @@ static Element makeSheathGraph(const sheath::SheathResults& res,
 // ─────────────────────────────────────────────────────────────────────────────
 // makeSheathTab
 // ─────────────────────────────────────────────────────────────────────────────
-static Element makeSheathTab(Element leftPanel,
-                              const sheath::SheathResults& results)
+static Element makeSheathResults(const sheath::SheathResults& results)
 {
     Element right;
     if (!results.valid) {
@@ -383,11 +474,7 @@ static Element makeSheathTab(Element leftPanel,
                 text(" " + unit) | dim, text("  "),
             });
         };
-        auto fv = [](double v) {
-            std::ostringstream s;
-            s << std::fixed << std::setprecision(1) << v;
-            return s.str();
-        };
+        auto fv = [](double v) { return fmt(v, 1); };
         right = window(
             text(" Sheath Voltage Profile "),
             vbox({
@@ -404,47 +491,160 @@ static Element makeSheathTab(Element leftPanel,
                     text("Cross-bond") | dim,
                 }),
                 separator(),
-                srow("Peak sheath voltage  A", fv(results.maxVoltage_A), "V", Color::Cyan),
-                srow("Peak sheath voltage  B", fv(results.maxVoltage_B), "V", Color::Yellow),
-                srow("Peak sheath voltage  C", fv(results.maxVoltage_C), "V", Color::Magenta),
+                srow("Peak sheath voltage  A", fv(results.maxVoltage_A),
+                     "V @ " + fv(results.maxLocation_A) + " m", Color::Cyan),
+                srow("Peak sheath voltage  B", fv(results.maxVoltage_B),
+                     "V @ " + fv(results.maxLocation_B) + " m", Color::Yellow),
+                srow("Peak sheath voltage  C", fv(results.maxVoltage_C),
+                     "V @ " + fv(results.maxLocation_C) + " m", Color::Magenta),
                 separator(),
                 srow("Total route length",
-                     std::to_string(results.totalLength) + " m", "", Color::White),
+                     fv(results.totalLength) + " m", "", Color::White),
                 srow("Cross-bond points",
                      std::to_string(results.minorBoundaries.size()), "", Color::White),
             }) | flex
         ) | flex;
     }
-    return hbox({ leftPanel | size(WIDTH, EQUAL, 72), right }) | flex;
+    return right;
+}
+
+static Element makeSheathTab(Element leftPanel, Element resultsPanel)
+{
+    return hbox({ leftPanel | size(WIDTH, EQUAL, 72), resultsPanel }) | flex;
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-// main
+// runImport — `cableTool --import <catalogue.csv|.json>`
+// Loads a manufacturer catalogue into cable_design.db without starting the UI.
 // ─────────────────────────────────────────────────────────────────────────────
-int main()
+static int runImport(const std::string& path)
 {
-    // ── Open database ─────────────────────────────────────────────────────────
-    DatabaseManager db;
-    std::string dbError;
+    using clock = std::chrono::steady_clock;
+    const auto t0 = clock::now();
+
+    std::vector<CableRecord> records;
+    std::vector<std::string> manufacturers;
+    std::string error;
+    if (!catalogue::parseFile(path, records, manufacturers, error)) {
+        std::fprintf(stderr, "Import failed: %s\n", error.c_str());
+        return 1;
+    }
+    const auto t1 = clock::now();
 
+    DatabaseManager db;
     if (!db.open()) {
-        dbError = "DB error: " + db.errorMessage();
+        std::fprintf(stderr, "DB error: %s\n", db.errorMessage().c_str());
+        return 1;
     }
 
-    // Load records once at startup
-    std::vector<CableRecord> allRecords = db.isOpen()
-        ? db.allRecords()
-        : std::vector<CableRecord>{};
-    std::vector<int> sizes = db.isOpen()
-        ? db.availableSizes()
-        : std::vector<int>{};
+    // Catalogue-local manufacturer numbers → database ids
+    std::vector<int> ids;
+    for (const auto& name : manufacturers) {
+        const int id = db.manufacturerId(name);
+        if (id == 0) {
+            std::fprintf(stderr, "Import failed: %s\n", db.errorMessage().c_str());
+            return 1;
+        }
+        ids.push_back(id);
+    }
+    for (auto& r : records)
+        r.manufacturerId = ids[static_cast<size_t>(r.manufacturerId - 1)];
+
+    const bool ok = db.importRecords(records, [](size_t done, size_t total) {
+        std::fprintf(stderr, "\r  %zu / %zu records", done, total);
+    });
+    std::fprintf(stderr, "\n");
+    if (!ok) {
+        std::fprintf(stderr, "Import failed: %s\n", db.errorMessage().c_str());
+        return 1;
+    }
+
+    auto ms = [](clock::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    };
+    std::fprintf(stderr, "Imported %zu records from %s (parse %.0f ms, load %.0f ms)\n",
+                 records.size(), path.c_str(), ms(t1 - t0), ms(clock::now() - t1));
+    return 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// main
+// ─────────────────────────────────────────────────────────────────────────────
+int main(int argc, char* argv[])
+{
+    if (argc >= 2 && std::string(argv[1]) == "--import") {
+        if (argc < 3) {
+            std::fprintf(stderr, "Usage: %s --import <catalogue.csv|catalogue.json>\n", argv[0]);
+            return 2;
+        }
+        return runImport(argv[2]);
+    }
+
+    // ── Load catalogue ────────────────────────────────────────────────────────
+    // The UI works on the design catalogue — one record per size, so
+    // allRecords and sizes stay index-aligned.  Other imported catalogues
+    // are left in the database.
+    CableFilter designCatalogue;
+    designCatalogue.manufacturerId = 1;   // Generic
+    designCatalogue.voltageKV      = 33.0;
+    designCatalogue.material       = ConductorMaterial::Cu;
+    designCatalogue.insulation     = Insulation::XLPE;
+
+    // A snapshot whose catalogue version matches the database's is used
+    // straight from the mapping, as is one shipped without a database.  The
+    // check is a single read-only SELECT; only a stale snapshot opens the
+    // database properly (schema, seeding), reads the catalogue and rewrites
+    // the snapshot for next time.
+    const std::string dbPath       = "cable_design.db";
+    const std::string snapshotPath = CatalogueSnapshot::pathFor(dbPath);
+
+    std::vector<CableRecord> allRecords;
+    std::string dbError;
+    std::string catalogueSource;   // Empty → built-in fallback
+
+    CatalogueSnapshot snapshot;
+    std::error_code   noDb;
+    bool current = false;
+    if (snapshot.open(snapshotPath)) {
+        current = !std::filesystem::exists(dbPath, noDb) ||
+                  snapshot.isCurrent(DatabaseManager::storedCatalogueVersion(dbPath));
+    }
+    if (current) {
+        for (const auto& r : snapshot)
+            if (designCatalogue.matches(r)) allRecords.push_back(r);
+        catalogueSource = snapshotPath;
+    } else {
+        snapshot.close();
+        DatabaseManager db;
+        if (db.open(dbPath)) {
+            // Version first: a change landing in between leaves the snapshot
+            // stamped older than its records, so it is only rewritten again
+            const long long version = db.catalogueVersion();
+            const std::vector<CableRecord> catalogue = db.allRecords();
+            for (const auto& r : catalogue)
+                if (designCatalogue.matches(r)) allRecords.push_back(r);
+            catalogueSource = dbPath;
+
+            std::string error;   // Best effort — a read-only install just skips it
+            CatalogueSnapshot::write(snapshotPath, catalogue, version, error);
+        } else {
+            dbError = "DB error: " + db.errorMessage();
+        }
+    }
 
     // Graceful fallback to static data if DB failed
-    if (allRecords.empty()) {
+    if (allRecords.empty())
         allRecords = std::vector<CableRecord>(
             cableDatabase().begin(), cableDatabase().end());
-        for (const auto& r : allRecords) sizes.push_back(r.sizeMm2);
-    }
+
+    std::vector<int> sizes;
+    for (const auto& r : allRecords) sizes.push_back(r.sizeMm2);
+
+    // Current ratings for every size and arrangement, index-aligned with
+    // allRecords (default installation: buried direct, screens bonded at
+    // both ends)
+    const Installation             installation;
+    const std::vector<AmpacityRow> ratings = rateCatalogue(allRecords, installation);
 
     // ── Tab state ─────────────────────────────────────────────────────────────
     std::vector<std::string> tabLabels = {
@@ -457,6 +657,8 @@ int main()
     std::string powerStr       = "10.0";
     std::string pfStr          = "0.95";
     std::string lengthStr      = "1.0";
+    std::string maxDvStr       = "3.0";
+    std::string maxLossStr     = "2.0";
     int         arrangementIdx = 0;
     int         sizeIdx        = 0;
 
@@ -470,16 +672,35 @@ int main()
     for (int s : sizes)
         sizeLabels.push_back(std::to_string(s) + " mm2");
 
-    CalcResults results;
-    bool        calculated = false;
+    CalcResults   results;
+    bool          calculated = false;
+    std::uint64_t resultsKey = 0;   // inputHash() of the inputs behind results
     std::string errorMsg   = dbError;
 
+    OptimiserResult      optResult;
+    OptimiserConstraints optLimits;
+    bool                 optimised = false;
+
+    // Bumped whenever results, optResult, calculated or optimised change;
+    // keys the cached output panels.
+    unsigned resultsVersion = 0;
+
     // ── Screen + components ───────────────────────────────────────────────────
     auto screen          = ScreenInteractive::Fullscreen();
+
+    // Calculations run on these, off the event loop.  Results come back
+    // through screen.Post(); progress and completion wake the loop to redraw.
+    auto redraw = [&screen] { screen.PostEvent(Event::Custom); };
+    BackgroundWorker sysWorker(redraw);
+    BackgroundWorker svWorker(redraw);
+    BackgroundWorker exportWorker(redraw);   // Separate, so solves never cancel an export
+
     auto voltageInput    = Input(&voltageStr,  "33.0");
     auto powerInput      = Input(&powerStr,    "10.0");
     auto pfInput         = Input(&pfStr,       "0.95");
     auto lengthInput     = Input(&lengthStr,   "1.0");
+    auto maxDvInput      = Input(&maxDvStr,    "3.0");
+    auto maxLossInput    = Input(&maxLossStr,  "2.0");
     auto arrangementMenu = Radiobox(&arrangementLabels, &arrangementIdx);
     // focused_entry keeps the selected item scrolled into view automatically
     auto sizeMenuOpt        = MenuOption::Vertical();
@@ -503,26 +724,75 @@ int main()
                 return;
             }
 
-            CableRecord cable = db.isOpen()
-                ? db.recordBySize(p.sizeMm2)
-                : [&]() -> CableRecord {
-                    const CableRecord* p2 = findBySize(p.sizeMm2);
-                    return p2 ? *p2 : CableRecord{};
-                  }();
-
-            results    = calculate(p, cable);
-            calculated = true;
+            const CableRecord cable = allRecords[sizeIdx];
+            sysWorker.start([&, p, cable](BackgroundWorker::Context& ctx) {
+                const CalcResults   r   = calculate(p, cable);
+                const std::uint64_t key = inputHash(p, cable);
+                screen.Post([&, token = ctx.token(), r, key] {
+                    if (token.cancelled()) return;
+                    results    = r;
+                    resultsKey = key;
+                    calculated = true;
+                    optimised  = false;
+                    ++resultsVersion;
+                });
+            });
         } catch (...) {
             errorMsg = "Parse error - ensure all fields contain valid numbers";
         }
     }, ButtonOption::Animated(Color::Green));
 
+    auto optimiseButton = Button("  Optimise [F6]  ", [&] {
+        errorMsg.clear();
+        try {
+            SystemParams p;
+            p.voltageKV   = std::stod(voltageStr);
+            p.powerMVA    = std::stod(powerStr);
+            p.powerFactor = std::stod(pfStr);
+            p.lengthKm    = std::stod(lengthStr);
+
+            OptimiserConstraints limits;
+            limits.maxDeltaV_pct = std::stod(maxDvStr);
+            limits.maxLosses_pct = std::stod(maxLossStr);
+
+            if (p.voltageKV <= 0 || p.powerMVA <= 0 ||
+                p.powerFactor <= 0 || p.powerFactor > 1 || p.lengthKm <= 0) {
+                errorMsg = "Invalid input - check values are positive and PF <= 1";
+                return;
+            }
+            if (limits.maxDeltaV_pct <= 0 || limits.maxLosses_pct <= 0) {
+                errorMsg = "Limits must be > 0";
+                return;
+            }
+
+            optResult = optimise(p, allRecords, limits);
+            optLimits = limits;
+            optimised = true;
+            ++resultsVersion;
+
+            // Select the best candidate so [Calculate] shows its full results
+            if (!optResult.feasible.empty()) {
+                const auto& best = optResult.feasible.front();
+                arrangementIdx = static_cast<int>(best.arrangement);
+                for (int i = 0; i < (int)sizes.size(); ++i)
+                    if (sizes[i] == best.sizeMm2) { sizeIdx = i; break; }
+            }
+        } catch (...) {
+            errorMsg = "Parse error - ensure all fields contain valid numbers";
+        }
+    }, ButtonOption::Animated(Color::Blue));
+
     // ── System tab ────────────────────────────────────────────────────────────
     auto systemInputs = Container::Vertical({
         voltageInput, powerInput, pfInput, lengthInput,
-        arrangementMenu, sizeMenu, calcButton
+        arrangementMenu, sizeMenu, calcButton,
+        maxDvInput, maxLossInput, optimiseButton
     });
 
+    // The output panels only change with the results or the inputs they echo
+    ElementCache<unsigned> optimiserPanel;
+    ElementCache<std::tuple<unsigned, double, double, double, double, int, int>> outputPanel;
+
     auto systemRenderer = Renderer(systemInputs, [&] {
         SystemParams p;
         try {
@@ -557,15 +827,31 @@ int main()
                                    | size(HEIGHT, LESS_THAN, 8),
                 separator(),
                 calcButton->Render() | center,
+                separator(),
+                text(" Optimiser limits:") | dim,
+                labelledInput("Max voltage drop [%]: ", maxDvInput->Render()),
+                labelledInput("Max losses [%]      : ", maxLossInput->Render()),
+                optimiseButton->Render() | center,
                 errorMsg.empty()
                     ? text("")
                     : text(" [!] " + errorMsg) | color(Color::Red),
             })
         );
 
+        Element outputPane = optimised
+            ? optimiserPanel.get(resultsVersion, [&] {
+                  return makeOptimiserPanel(optResult, optLimits);
+              })
+            : outputPanel.get(std::make_tuple(resultsVersion, p.voltageKV, p.powerMVA,
+                                              p.powerFactor, p.lengthKm, p.sizeMm2,
+                                              arrangementIdx), [&] {
+                  return makeOutputPanel(results, p, ratings[sizeIdx][arrangementIdx],
+                                         calculated) | flex;
+              });
+
         return hbox({
             inputPane  | size(WIDTH, EQUAL, 46),
-            makeOutputPanel(results, p, calculated) | flex,
+            outputPane,
         }) | flex;
     });
 
@@ -599,19 +885,186 @@ int main()
     std::deque<SvRow> svRows;
     svRows.push_back(SvRow{});
 
-    sheath::SheathResults svResults;
-    std::string           svError;
-    int                   svSelectedRow = 0;
+    sheath::SheathResults      svResults;
+    std::vector<std::uint64_t> svKeys;   // sectionKeys() svResults was solved with
+    unsigned                   svVersion = 0;   // Bumped with every svResults change
+    ElementCache<unsigned>     svResultsPanel;
+    std::string                svError;
+    int                        svSelectedRow = 0;
+
+    // Live mode re-solves as the route is edited.  Every edit reports itself
+    // to svLiveEdit(): input fields from their on_change, the row shortcuts,
+    // row buttons and formula from their handlers.  svLiveParams holds the
+    // route as last parsed and svLiveKeys its sectionKeys(), so an edit to
+    // one row re-parses that row and re-hashes from it onwards; svLiveKeys
+    // is empty when the next edit must re-parse everything.  svStartedKeys
+    // are the keys of the last solve started, so unchanged inputs (or ones
+    // already being solved) start nothing.  A field that does not parse
+    // keeps its error in svLiveError until focus leaves it (svLiveField).
+    bool                       svLive = false;
+    sheath::SheathParams       svLiveParams;
+    std::vector<std::uint64_t> svLiveKeys;
+    std::vector<std::uint64_t> svStartedKeys;
+    std::string                svLiveError;
+    std::weak_ptr<ComponentBase> svLiveField;
+
+    // Saved studies live in the catalogue database, opened per save/load
+    std::string svStudyName;
+    std::string svStudyMsg;
 
     std::string svCurrStr    = "0";
     std::string svFreqStr    = "50";
+    std::string svStepStr    = "1";
     int         svFormulaIdx = 1;
     std::vector<std::string> svFormulaLabels = { "Simplified", "Full" };
 
+    // One route section from its row; false (with `error` set) if a field
+    // does not parse.
+    auto parseSvRow = [](const SvRow& row, sheath::RouteSection& sec,
+                         std::string& error) -> bool {
+        try {
+            sec.length_m  = std::stod(row.length);
+            sec.transpose = row.transpose;
+            sec.label     = row.label;
+
+            if (row.arr == SvArr::Trefoil || row.arr == SvArr::FlatTouch) {
+                auto [sab, sbc, sac] = svSpacings(row.arr, std::stod(row.Sab));
+                sec.Sab_mm = sab;
+                sec.Sbc_mm = sbc;
+                sec.Sac_mm = sac;
+            } else {
+                sec.Sab_mm = std::stod(row.Sab);
+                sec.Sbc_mm = std::stod(row.Sbc);
+                sec.Sac_mm = std::stod(row.Sac);
+            }
+            return true;
+        } catch (const std::exception& ex) {
+            error = std::string("Parse error: ") + ex.what();
+        } catch (...) {
+            error = "Parse error — check numeric fields";
+        }
+        return false;
+    };
+
+    // Route parameters from the input fields; false (with `error` set) if
+    // they do not parse or are out of range.
+    auto buildSvParams = [&](sheath::SheathParams& p, std::string& error) -> bool {
+        try {
+            p.current_A    = std::stod(svCurrStr);
+            p.frequency_Hz = std::stod(svFreqStr);
+            p.step_m       = std::stod(svStepStr);
+        } catch (const std::exception& ex) {
+            error = std::string("Parse error: ") + ex.what();
+            return false;
+        }
+        if (p.current_A <= 0.0) {
+            error = "Current must be > 0";
+            return false;
+        }
+        if (p.step_m <= 0.0) {
+            error = "Resolution must be > 0";
+            return false;
+        }
+        p.formula = (svFormulaIdx == 0)
+                    ? sheath::SheathParams::Formula::SIMPLIFIED
+                    : sheath::SheathParams::Formula::FULL;
+
+        p.route.resize(svRows.size());
+        for (size_t i = 0; i < svRows.size(); ++i)
+            if (!parseSvRow(svRows[i], p.route[i], error)) return false;
+        return true;
+    };
+
+    // Solve `p` (whose sectionKeys() are `keys`) on svWorker, reusing the
+    // leading sections of `prior` whose keys still match; the march restarts
+    // at the first changed section.  With no section to reuse the prior is
+    // not copied to the worker at all.  The graph draws from the section
+    // solutions, so no profile is expanded.
+    auto svSolve = [&](sheath::SheathParams p, std::vector<std::uint64_t> keys,
+                       const sheath::SheathResults& prior,
+                       const std::vector<std::uint64_t>& priorKeys) {
+        const bool reuse = prior.valid && !keys.empty() && !priorKeys.empty()
+                        && keys[0] == priorKeys[0];
+        svStartedKeys = keys;
+        svWorker.start([&, p = std::move(p), keys = std::move(keys),
+                        prior = reuse ? prior : sheath::SheathResults{},
+                        priorKeys = reuse ? priorKeys : std::vector<std::uint64_t>{}]
+                       (BackgroundWorker::Context& ctx) {
+            sheath::SheathResults res = sheath::solveIncremental(
+                p, keys, prior, priorKeys, nullptr,
+                [&ctx](double f) { return ctx.progress(f); });
+            if (ctx.cancelled()) return;
+
+            screen.Post([&, token = ctx.token(), res = std::move(res), keys]() mutable {
+                if (token.cancelled()) return;
+                svResults = std::move(res);
+                ++svVersion;
+                if (svResults.valid) {
+                    svKeys = keys;
+                } else {
+                    svKeys.clear();
+                    svError = svResults.errorMsg;
+                }
+            });
+        });
+    };
+
+    // Live mode: `row` was edited (-1 for anything route-wide) through
+    // `field`, if it was an input field.  Only a change in the section keys
+    // starts a solve.
+    auto svLiveEdit = [&](int row, const Component& field) {
+        if (!svLive) {
+            svLiveKeys.clear();   // Edits are not being tracked
+            return;
+        }
+
+        std::string error;
+        size_t      from = 0;
+        bool        ok;
+        if (row >= 0 && svLiveKeys.size() == svRows.size()) {
+            from = static_cast<size_t>(row);
+            ok   = parseSvRow(svRows[from], svLiveParams.route[from], error);
+        } else {
+            svLiveParams = {};
+            ok = buildSvParams(svLiveParams, error);
+        }
+        if (!ok) {
+            svLiveKeys.clear();
+            svStartedKeys.clear();   // Re-solve, clearing svError, once it parses
+            svLiveError = std::move(error);
+            svLiveField = field;
+            return;
+        }
+        svLiveError.clear();
+
+        svLiveKeys = sheath::sectionKeys(svLiveParams, svLiveKeys, from);
+        if (svLiveKeys == svStartedKeys) return;
+        svError.clear();
+        svSolve(svLiveParams, svLiveKeys, svResults, svKeys);
+    };
+
+    // An input field that reports its edits to svLiveEdit() as `row`
+    auto liveInput = [&](std::string* content, const char* placeholder, int row) {
+        auto self = std::make_shared<std::weak_ptr<ComponentBase>>();
+        InputOption option;
+        option.on_change = [&, self, row] { svLiveEdit(row, self->lock()); };
+        Component input = Input(content, placeholder, option);
+        *self = input;
+        return input;
+    };
+
     // Fixed top-level inputs
-    auto svCurrInput    = Input(&svCurrStr, "A");
-    auto svFreqInput    = Input(&svFreqStr, "Hz");
-    auto svFormulaRadio = Radiobox(&svFormulaLabels, &svFormulaIdx);
+    RadioboxOption svFormulaOption;
+    svFormulaOption.on_change = [&] { svLiveEdit(-1, nullptr); };
+    CheckboxOption svLiveOption = CheckboxOption::Simple();
+    svLiveOption.on_change = [&] { svLiveEdit(-1, nullptr); };
+
+    auto svCurrInput    = liveInput(&svCurrStr, "A", -1);
+    auto svFreqInput    = liveInput(&svFreqStr, "Hz", -1);
+    auto svStepInput    = liveInput(&svStepStr, "m", -1);
+    auto svFormulaRadio = Radiobox(&svFormulaLabels, &svFormulaIdx, svFormulaOption);
+    auto svStudyInput   = Input(&svStudyName, "study name");
+    auto svLiveCheckbox = Checkbox("Live", &svLive, svLiveOption);
 
     // Per-row component bundle — created once, stored stably
     struct SvRowComps {
@@ -619,17 +1072,17 @@ int main()
     };
     std::deque<SvRowComps> svRowComps;
 
-    // Create components for one row, binding to its stable string addresses
-    auto makeRowComps = [](SvRow& row) -> SvRowComps {
+    // Create components for row `i`, binding to its stable string addresses
+    auto makeRowComps = [&](SvRow& row, int i) -> SvRowComps {
         return {
-            Input(&row.length, "m"),
-            Input(&row.Sab,    "mm"),
-            Input(&row.Sbc,    "mm"),
-            Input(&row.Sac,    "mm"),
-            Input(&row.label,  "label"),
+            liveInput(&row.length, "m",     i),
+            liveInput(&row.Sab,    "mm",    i),
+            liveInput(&row.Sbc,    "mm",    i),
+            liveInput(&row.Sac,    "mm",    i),
+            liveInput(&row.label,  "label", i),
         };
     };
-    svRowComps.push_back(makeRowComps(svRows[0]));
+    svRowComps.push_back(makeRowComps(svRows[0], 0));
 
     // The rows sub-container — we Add/DetachAllChildren on this directly
     auto svRowsContainer = Container::Vertical({
@@ -654,49 +1107,26 @@ int main()
 
     auto svCalcButton = Button("  Calculate  ", [&] {
         svError.clear();
-        try {
-            sheath::SheathParams p;
-            p.current_A    = std::stod(svCurrStr);
-            p.frequency_Hz = std::stod(svFreqStr);
-            if (p.current_A <= 0.0) {
-                svError = "Current must be > 0";
-                return;
-            }
-            p.formula = (svFormulaIdx == 0)
-                        ? sheath::SheathParams::Formula::SIMPLIFIED
-                        : sheath::SheathParams::Formula::FULL;
-
-            for (const auto& row : svRows) {
-                sheath::RouteSection sec;
-                sec.length_m  = std::stod(row.length);
-                sec.transpose = row.transpose;
-                sec.label     = row.label;
+        sheath::SheathParams p;
+        if (!buildSvParams(p, svError)) return;
+        auto keys = sheath::sectionKeys(p);
+        svSolve(std::move(p), std::move(keys), svResults, svKeys);
+    }, ButtonOption::Animated(Color::Green));
 
-                if (row.arr == SvArr::Trefoil || row.arr == SvArr::FlatTouch) {
-                    auto [sab, sbc, sac] = svSpacings(row.arr, std::stod(row.Sab));
-                    sec.Sab_mm = sab;
-                    sec.Sbc_mm = sbc;
-                    sec.Sac_mm = sac;
-                } else {
-                    sec.Sab_mm = std::stod(row.Sab);
-                    sec.Sbc_mm = std::stod(row.Sbc);
-                    sec.Sac_mm = std::stod(row.Sac);
-                }
-                p.route.push_back(sec);
-            }
-            svResults = sheath::calculate(p);
-            if (!svResults.valid) svError = svResults.errorMsg;
-        } catch (const std::exception& ex) {
-            svError = std::string("Parse error: ") + ex.what();
-        } catch (...) {
-            svError = "Parse error — check numeric fields";
+    auto svCancelButton = Button(" Cancel ", [&] {
+        svWorker.cancel();
+        if (exportWorker.busy()) {
+            exportWorker.cancel();
+            svStudyMsg = "Export cancelled";
         }
-    }, ButtonOption::Animated(Color::Green));
+    }, ButtonOption::Simple());
 
     auto svAddRowButton = Button(" + ", [&] {
         svRows.push_back(SvRow{});
-        svRowComps.push_back(makeRowComps(svRows.back()));
+        svRowComps.push_back(makeRowComps(svRows.back(),
+                                          static_cast<int>(svRows.size()) - 1));
         refreshRowsContainer();
+        svLiveEdit(-1, nullptr);
     }, ButtonOption::Simple());
 
     auto svDelRowButton = Button(" - ", [&] {
@@ -706,29 +1136,234 @@ int main()
             svSelectedRow = std::min(svSelectedRow,
                                      static_cast<int>(svRows.size()) - 1);
             refreshRowsContainer();
+            svLiveEdit(-1, nullptr);
         }
     }, ButtonOption::Simple());
 
     auto svClearButton = Button(" Clear ", [&] {
+        svWorker.cancel();
         svRows.clear();
         svRowComps.clear();
         svRows.push_back(SvRow{});
-        svRowComps.push_back(makeRowComps(svRows[0]));
+        svRowComps.push_back(makeRowComps(svRows[0], 0));
         svResults     = {};
+        svKeys.clear();
+        ++svVersion;
         svSelectedRow = 0;
         svError.clear();
         refreshRowsContainer();
+        svLiveEdit(-1, nullptr);
+    }, ButtonOption::Simple());
+
+    // Save both tabs' inputs, with whichever results still match them
+    auto svSaveButton = Button(" Save ", [&] {
+        svError.clear();
+        svStudyMsg.clear();
+        if (svStudyName.empty()) {
+            svError = "Enter a study name";
+            return;
+        }
+
+        Study study;
+        study.name = svStudyName;
+        try {
+            SystemParams& p = study.system;
+            p.voltageKV   = std::stod(voltageStr);
+            p.powerMVA    = std::stod(powerStr);
+            p.powerFactor = std::stod(pfStr);
+            p.lengthKm    = std::stod(lengthStr);
+            p.arrangement = static_cast<Arrangement>(arrangementIdx);
+            p.sizeMm2     = sizes[sizeIdx];
+        } catch (...) {
+            svError = "Parse error in System tab — check numeric fields";
+            return;
+        }
+        study.systemKey     = inputHash(study.system, allRecords[sizeIdx]);
+        study.systemSolved  = calculated && resultsKey == study.systemKey;
+        study.systemResults = results;
+
+        if (!buildSvParams(study.sheath, svError)) return;
+        for (const auto& row : svRows)
+            study.sectionLayouts.push_back(static_cast<int>(row.arr));
+        study.sectionKeys   = svKeys;
+        study.sheathResults = svResults;
+
+        DatabaseManager db;
+        if (!db.open(dbPath) || !db.saveStudy(study)) {
+            svError = db.errorMessage();
+            return;
+        }
+        svStudyMsg = "Saved '" + study.name + "'";
+    }, ButtonOption::Simple());
+
+    // Load a study into both tabs.  Stored results are used where their keys
+    // match the restored inputs; anything else is recalculated.
+    auto svLoadButton = Button(" Load ", [&] {
+        svError.clear();
+        svStudyMsg.clear();
+
+        Study study;
+        DatabaseManager db;
+        if (!db.open(dbPath)) {
+            svError = db.errorMessage();
+            return;
+        }
+        if (!db.loadStudy(svStudyName, study)) {
+            if (!db.errorMessage().empty()) {
+                svError = db.errorMessage();
+                return;
+            }
+            std::string saved;
+            for (const auto& name : db.studyNames())
+                saved += (saved.empty() ? "" : ", ") + name;
+            svError = "No study '" + svStudyName + "'"
+                    + (saved.empty() ? "" : " (saved: " + saved + ")");
+            return;
+        }
+
+        // Anything still calculating is for the inputs being replaced
+        sysWorker.cancel();
+        svWorker.cancel();
+
+        // System tab
+        const SystemParams& sp = study.system;
+        voltageStr     = fmtInput(sp.voltageKV);
+        powerStr       = fmtInput(sp.powerMVA);
+        pfStr          = fmtInput(sp.powerFactor);
+        lengthStr      = fmtInput(sp.lengthKm);
+        arrangementIdx = static_cast<int>(sp.arrangement);
+        calculated     = false;
+        optimised      = false;
+        ++resultsVersion;
+        const auto size = std::find(sizes.begin(), sizes.end(), sp.sizeMm2);
+        if (size != sizes.end()) {
+            sizeIdx    = static_cast<int>(size - sizes.begin());
+            resultsKey = inputHash(sp, allRecords[sizeIdx]);
+            if (study.systemSolved && study.systemKey == resultsKey) {
+                results    = study.systemResults;
+                calculated = true;
+            } else if (sp.voltageKV > 0 && sp.powerMVA > 0 && sp.powerFactor > 0 &&
+                       sp.powerFactor <= 1 && sp.lengthKm > 0) {
+                results    = calculate(sp, allRecords[sizeIdx]);
+                calculated = true;
+            }
+        }
+
+        // Sheath tab
+        const sheath::SheathParams& p = study.sheath;
+        svCurrStr    = fmtInput(p.current_A);
+        svFreqStr    = fmtInput(p.frequency_Hz);
+        svStepStr    = fmtInput(p.step_m);
+        svFormulaIdx = (p.formula == sheath::SheathParams::Formula::SIMPLIFIED) ? 0 : 1;
+
+        svRows.clear();
+        svRowComps.clear();
+        for (size_t i = 0; i < p.route.size(); ++i) {
+            const auto& sec = p.route[i];
+            // Layout codes come back from the database; an unknown one reads
+            // as Custom, which keeps the section's stored spacings as they are
+            const int layout = (i < study.sectionLayouts.size()) ? study.sectionLayouts[i] : -1;
+            SvRow row;
+            row.arr       = (layout >= static_cast<int>(SvArr::Trefoil) &&
+                             layout <= static_cast<int>(SvArr::Custom))
+                          ? static_cast<SvArr>(layout) : SvArr::Custom;
+            row.transpose = sec.transpose;
+            row.length    = fmtInput(sec.length_m);
+            row.Sab       = fmtInput(sec.Sab_mm);
+            row.Sbc       = fmtInput(sec.Sbc_mm);
+            row.Sac       = fmtInput(sec.Sac_mm);
+            row.label     = sec.label;
+            svRows.push_back(row);
+            svRowComps.push_back(makeRowComps(svRows.back(), static_cast<int>(i)));
+        }
+        if (svRows.empty()) {
+            svRows.push_back(SvRow{});
+            svRowComps.push_back(makeRowComps(svRows[0], 0));
+        }
+        svSelectedRow = 0;
+        refreshRowsContainer();
+
+        svLiveKeys.clear();   // svLiveParams is no longer the route on screen
+        svSolve(p, sheath::sectionKeys(p), study.sheathResults, study.sectionKeys);
+        svStudyMsg = "Loaded '" + study.name + "'";
+    }, ButtonOption::Simple());
+
+    // Write the sampled |E| profile to <study name>.csv (sheath_profile.csv
+    // when unnamed) on exportWorker, streaming samples so long routes never
+    // hold a profile.  A cancelled export leaves no partial file.
+    auto svExportButton = Button(" Export ", [&] {
+        svError.clear();
+        svStudyMsg.clear();
+        if (!svResults.valid) {
+            svError = "Nothing to export — calculate first";
+            return;
+        }
+
+        std::string path = (svStudyName.empty() ? "sheath_profile" : svStudyName) + ".csv";
+        svStudyMsg = "Exporting to " + path;
+        exportWorker.start([&, res = svResults, path = std::move(path)]
+                           (BackgroundWorker::Context& ctx) {
+            std::string error;
+            size_t      samples = 0;
+            if (std::FILE* file = std::fopen(path.c_str(), "wb")) {
+                bool ok;
+                {
+                    format::CsvWriter csv(file);
+                    csv.field("distance_m");
+                    csv.field("A_V");
+                    csv.field("B_V");
+                    csv.field("C_V");
+                    csv.endRow();
+                    sheath::forEachSample(res,
+                        [&](double x, const std::array<std::complex<double>, 3>& E) {
+                            csv.field(x, 3);
+                            for (const auto& e : E) csv.field(sheath::magnitude(e), 3);
+                            csv.endRow();
+                            ++samples;
+                        },
+                        [&ctx](double f) { return ctx.progress(f); });
+                    ok = csv.flush();
+                }
+                ok = (std::fclose(file) == 0) && ok;
+                if (ctx.cancelled()) {
+                    std::remove(path.c_str());
+                    return;
+                }
+                if (!ok) error = "Write error on " + path;
+            } else {
+                error = "Cannot open " + path;
+            }
+
+            screen.Post([&, token = ctx.token(), path, samples, error] {
+                if (token.cancelled()) return;
+                if (!error.empty()) {
+                    svStudyMsg.clear();
+                    svError = error;
+                    return;
+                }
+                svStudyMsg = "Exported " + std::to_string(samples) + " samples to " + path;
+            });
+        });
     }, ButtonOption::Simple());
 
     // Single stable container — never rebuilt
     auto svContainer = Container::Vertical({
-        svCurrInput, svFreqInput, svFormulaRadio,
+        svCurrInput, svFreqInput, svStepInput, svFormulaRadio,
         svRowsContainer,
         svAddRowButton, svDelRowButton, svClearButton,
-        svCalcButton,
+        svStudyInput, svSaveButton, svLoadButton, svExportButton,
+        svCalcButton, svCancelButton, svLiveCheckbox,
     });
 
     auto svRenderer = Renderer(svContainer, [&]() -> Element {
+        // A live parse error is held until focus leaves the field it is in
+        if (!svLiveError.empty()) {
+            const Component field = svLiveField.lock();
+            if (!field || !field->Focused()) {
+                svError = std::move(svLiveError);
+                svLiveError.clear();
+            }
+        }
 
         auto li = [](const std::string& lbl, Element inp) {
             return hbox({
@@ -741,6 +1376,7 @@ int main()
             vbox({
                 li("Design current (A) : ", svCurrInput->Render()),
                 li("Frequency    (Hz) : ", svFreqInput->Render()),
+                li("Resolution    (m) : ", svStepInput->Render()),
                 separator(),
                 text(" EMF formula:") | dim,
                 hbox({ text("   "), svFormulaRadio->Render() }),
@@ -753,9 +1389,7 @@ int main()
             if (row.arr == SvArr::Trefoil || row.arr == SvArr::FlatTouch) {
                 try {
                     auto [sab, sbc, sac] = svSpacings(row.arr, std::stod(row.Sab));
-                    std::ostringstream s;
-                    s << std::fixed << std::setprecision(0) << sbc;
-                    return s.str();
+                    return fmt(sbc, 0);
                 } catch (...) { return "?"; }
             }
             return "";
@@ -764,9 +1398,7 @@ int main()
             if (row.arr == SvArr::Trefoil || row.arr == SvArr::FlatTouch) {
                 try {
                     auto [sab, sbc, sac] = svSpacings(row.arr, std::stod(row.Sab));
-                    std::ostringstream s;
-                    s << std::fixed << std::setprecision(0) << sac;
-                    return s.str();
+                    return fmt(sac, 0);
                 } catch (...) { return "?"; }
             }
             return "";
@@ -842,29 +1474,60 @@ int main()
                     text(" "),
                     svClearButton->Render(),
                 }),
+                hbox({
+                    text(" Study: ") | dim,
+                    svStudyInput->Render() | size(WIDTH, EQUAL, 20),
+                    text(" "),
+                    svSaveButton->Render(),
+                    text(" "),
+                    svLoadButton->Render(),
+                    text(" "),
+                    svExportButton->Render(),
+                    text(" " + svStudyMsg) | color(Color::Green),
+                }),
                 svError.empty()
                     ? text(" ")
                     : text(" [!] " + svError) | color(Color::Red),
             }) | vscroll_indicator | frame | size(HEIGHT, LESS_THAN, 26)
         );
 
+        Element calcRow = hbox({
+            svCalcButton->Render(), text(" "), svCancelButton->Render(),
+            text("  "), svLiveCheckbox->Render(),
+        }) | center;
+        if (svWorker.busy() || exportWorker.busy()) {
+            const bool   calc = svWorker.busy();
+            const double done = calc ? svWorker.progress() : exportWorker.progress();
+            calcRow = vbox({
+                calcRow,
+                hbox({
+                    text(calc ? " Calculating " : " Exporting ") | dim,
+                    gauge(static_cast<float>(done)) | color(Color::Green) | flex,
+                    text(" " + std::to_string(static_cast<int>(done * 100.0)) + "% "),
+                }),
+            });
+        }
+
         return makeSheathTab(
-            vbox({ sysPane, routePane, svCalcButton->Render() | center }),
-            svResults
+            vbox({ sysPane, routePane, calcRow }),
+            svResultsPanel.get(svVersion, [&] { return makeSheathResults(svResults); })
         );
     });
 
     // ── Cable Data tab ────────────────────────────────────────────────────────
     auto cableDataContainer = Container::Vertical({});
 
+    // The catalogue is fixed for the session, so its table is built once
+    const Element cableTable = makeCableTable(allRecords);
+
     auto cableDataComp = Renderer(cableDataContainer, [&] {
         return vbox({
             text(" 33 kV XLPE Cable Electrical Data") | bold | center,
-            text(db.isOpen()
-                ? " Source: cable_design.db"
+            text(!catalogueSource.empty()
+                ? " Source: " + catalogueSource
                 : " Source: built-in fallback (DB unavailable)") | dim | center,
             separator(),
-            makeCableTable(allRecords),
+            cableTable,
         }) | flex;
     });
 
@@ -885,9 +1548,9 @@ int main()
             separator(),
             tabContent->Render() | flex,
             hbox({
-                text(" F5/Enter = Calculate  |  DB: ") | dim,
-                db.isOpen()
-                    ? text("cable_design.db  OK") | color(Color::Green)
+                text(" F5/Enter = Calculate  |  F6 = Optimise  |  DB: ") | dim,
+                !catalogueSource.empty()
+                    ? text(catalogueSource + "  OK") | color(Color::Green)
                     : text("unavailable") | color(Color::Red),
                 filler(),
                 text(" CableDesign v1.2.0 ") | dim,
@@ -896,7 +1559,20 @@ int main()
     });
 
     auto appWithKeys = CatchEvent(mainRenderer, [&](Event event) {
+        // Typing a study name must not trigger the single-key shortcuts
+        if (event.is_character() && svStudyInput->Focused())
+            return false;
+        // Esc cancels a running calculation or export first; q always quits
+        if (event == Event::Escape &&
+            (sysWorker.busy() || svWorker.busy() || exportWorker.busy())) {
+            sysWorker.cancel();
+            svCancelButton->OnEvent(Event::Return);
+            return true;
+        }
         if (event == Event::Character('q') || event == Event::Escape) {
+            sysWorker.cancel();
+            svWorker.cancel();
+            exportWorker.cancel();
             screen.ExitLoopClosure()();
             return true;
         }
@@ -904,6 +1580,10 @@ int main()
             calcButton->OnEvent(Event::Return);
             return true;
         }
+        if (event == Event::F6 && activeTab == 0) {
+            optimiseButton->OnEvent(Event::Return);
+            return true;
+        }
         if (activeTab == 1) {
             // ↑ / ↓ — move row selection highlight
             if (event == Event::ArrowUp) {
@@ -920,13 +1600,16 @@ int main()
                 if (!svRows.empty()) {
                     svRows[svSelectedRow].arr =
                         svArrNext(svRows[svSelectedRow].arr);
+                    svLiveEdit(svSelectedRow, nullptr);
                 }
                 return true;
             }
             // T — toggle cross-bond on highlighted row
             if (event == Event::Character('t') || event == Event::Character('T')) {
-                if (!svRows.empty())
+                if (!svRows.empty()) {
                     svRows[svSelectedRow].transpose = !svRows[svSelectedRow].transpose;
+                    svLiveEdit(svSelectedRow, nullptr);
+                }
                 return true;
             }
             // + / - — add / remove row without reaching for the mouse